@@ -4,3 +4,23 @@
 std::vector<BasePart *> g_instances;
 lua_State *L_main = nullptr;
 Camera3D g_camera = {};
+
+void AddToRenderList(BasePart *part) {
+    if (part->RenderListIndex != BasePart::NotRendered)
+        return;
+
+    part->RenderListIndex = g_instances.size();
+    g_instances.push_back(part);
+}
+
+void RemoveFromRenderList(BasePart *part) {
+    size_t index = part->RenderListIndex;
+    if (index >= g_instances.size() || g_instances[index] != part)
+        return;
+
+    BasePart *last = g_instances.back();
+    g_instances[index] = last;
+    last->RenderListIndex = index;
+    g_instances.pop_back();
+    part->RenderListIndex = BasePart::NotRendered;
+}
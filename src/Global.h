@@ -11,4 +11,9 @@
 // Globals
 extern std::vector<BasePart *> g_instances;
 extern lua_State *L_main;
-extern Camera3D g_camera;
\ No newline at end of file
+extern Camera3D g_camera;
+
+// Render list membership in O(1), tracked through BasePart::RenderListIndex.
+// Removal swaps the last part into the freed slot, so order is not kept.
+void AddToRenderList(BasePart *part);
+void RemoveFromRenderList(BasePart *part);
\ No newline at end of file
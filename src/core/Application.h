@@ -29,6 +29,25 @@ protected:
     virtual void PostLuaInitialize() {}
     virtual void Cleanup() = 0;
 
+    // Tears down the game, services included, and closes Lua. Returns the
+    // number of instances still allocated afterwards, which should be 0.
+    size_t Shutdown() {
+        // Destroy while Lua is still open so Destroying handlers can run.
+        // Destroy() refuses the DataModel and services, so take everything
+        // down through DestroyAll.
+        Instance::DestroyAll();
+        if (L_main) {
+            lua_close(L_main);
+            L_main = nullptr;
+        }
+        while (Instance::FreeDestroyed())
+            ;
+
+        dataModel = nullptr;
+        workspace = nullptr;
+        return Instance::GetLiveCount();
+    }
+
 public:
     Application() {
         dataModel = DataModel::GetInstance();
@@ -36,12 +55,12 @@ public:
     }
 
     virtual ~Application() {
-        delete dataModel;
+        Shutdown();
+
         UnloadPrimitiveModels();
         g_instances.clear();
         UnloadSkybox();
         CloseWindow();
-        lua_close(L_main);
     }
 
     void Run() {
@@ -71,22 +90,13 @@ public:
         g_camera.projection = CAMERA_PERSPECTIVE;
 
         workspace->ChildAdded.Connect([](Instance *child) {
-            if (auto *part = dynamic_cast<BasePart *>(child)) {
-                if (std::find(g_instances.begin(), g_instances.end(), part) ==
-                    g_instances.end()) {
-                    g_instances.push_back(part);
-                }
-            }
+            if (auto *part = child->As<BasePart>())
+                AddToRenderList(part);
         });
 
         workspace->ChildRemoved.Connect([](Instance *child) {
-            if (auto *part = dynamic_cast<BasePart *>(child)) {
-                auto it =
-                    std::find(g_instances.begin(), g_instances.end(), part);
-                if (it != g_instances.end()) {
-                    g_instances.erase(it);
-                }
-            }
+            if (auto *part = child->As<BasePart>())
+                RemoveFromRenderList(part);
         });
 
         MainLoop();
@@ -0,0 +1,74 @@
+#include "ClassRegistry.h"
+#include <cstdio>
+#include <cstdlib>
+
+// Function-local statics so instances constructed during static
+// initialization can still look up their class id
+std::vector<ClassRegistry::ClassEntry> &ClassRegistry::Entries() {
+    static std::vector<ClassEntry> entries;
+    return entries;
+}
+
+std::unordered_map<std::string, ClassId> &ClassRegistry::Ids() {
+    static std::unordered_map<std::string, ClassId> ids;
+    return ids;
+}
+
+ClassId ClassRegistry::GetClassId(const std::string &className) {
+    auto &ids = Ids();
+    auto it = ids.find(className);
+    if (it != ids.end())
+        return it->second;
+
+    auto &entries = Entries();
+    if (entries.size() >= kMaxClasses) {
+        printf("ClassRegistry: too many classes, cannot register '%s'\n",
+               className.c_str());
+        abort();
+    }
+
+    ClassId id = (ClassId)entries.size();
+    ClassEntry entry;
+    entry.name = className;
+    entry.ancestry.set(id);
+    entries.push_back(entry);
+    ids[className] = id;
+    return id;
+}
+
+ClassId ClassRegistry::FindClassId(const std::string &className) {
+    auto &ids = Ids();
+    auto it = ids.find(className);
+    return (it != ids.end()) ? it->second : kInvalidClassId;
+}
+
+void ClassRegistry::Register(const std::string &className,
+                             const std::string &parentClassName) {
+    ClassId id = GetClassId(className);
+    ClassId parent =
+        parentClassName.empty() ? kInvalidClassId : GetClassId(parentClassName);
+    Entries()[id].parent = parent;
+    RebuildAncestry();
+}
+
+void ClassRegistry::RebuildAncestry() {
+    // Classes may be registered before their parents, so recompute every
+    // chain; this only runs at bind time and the class count is small
+    auto &entries = Entries();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ClassAncestry ancestry;
+        size_t depth = 0;
+        for (ClassId c = (ClassId)i; c != kInvalidClassId && depth < kMaxClasses;
+             c = entries[c].parent, ++depth)
+            ancestry.set(c);
+        entries[i].ancestry = ancestry;
+    }
+}
+
+const ClassAncestry &ClassRegistry::GetAncestry(ClassId classId) {
+    return Entries()[classId].ancestry;
+}
+
+const std::string &ClassRegistry::GetClassName(ClassId classId) {
+    return Entries()[classId].name;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compact numeric identifier for a registered class
+using ClassId = uint16_t;
+
+constexpr size_t kMaxClasses = 128;
+constexpr ClassId kInvalidClassId = UINT16_MAX;
+
+// Bit N is set when the class is, or inherits from, the class with id N
+using ClassAncestry = std::bitset<kMaxClasses>;
+
+class ClassRegistry {
+private:
+    struct ClassEntry {
+        std::string name;
+        ClassId parent = kInvalidClassId;
+        ClassAncestry ancestry;
+    };
+
+    static std::vector<ClassEntry> &Entries();
+    static std::unordered_map<std::string, ClassId> &Ids();
+
+    static void RebuildAncestry();
+
+public:
+    // Get the id for a class name, assigning a new one on first use
+    static ClassId GetClassId(const std::string &className);
+
+    // Get the id for a class name, or kInvalidClassId if it was never seen
+    static ClassId FindClassId(const std::string &className);
+
+    // Record the parent of a class and refresh the ancestry bitsets
+    static void Register(const std::string &className,
+                         const std::string &parentClassName);
+
+    static const ClassAncestry &GetAncestry(ClassId classId);
+    static const std::string &GetClassName(ClassId classId);
+
+    // Constant-time inheritance test
+    static bool IsA(ClassId classId, ClassId baseClassId) {
+        return baseClassId < kMaxClasses &&
+               GetAncestry(classId).test(baseClassId);
+    }
+};
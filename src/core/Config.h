@@ -19,4 +19,12 @@
     #major "." #minor "." #patch
 
 // Window Title Helper
-#define ENGINE_MAKE_WINDOW_TITLE(prefix) prefix " v" ENGINE_VERSION_STRING
\ No newline at end of file
+#define ENGINE_MAKE_WINDOW_TITLE(prefix) prefix " v" ENGINE_VERSION_STRING
+// Build Options (set from CMake; these are the defaults)
+#ifndef LEMON_INTERN_STRINGS
+#define LEMON_INTERN_STRINGS 1
+#endif
+
+#ifndef LEMON_POOLED_ALLOCATION
+#define LEMON_POOLED_ALLOCATION 1
+#endif
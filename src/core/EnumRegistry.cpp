@@ -1,6 +1,7 @@
 #include "EnumRegistry.h"
+#include "LuaAtoms.h"
+#include "LuaTags.h"
 
-static const char *kEnumItemMeta = "EnumItem";
 static const char *kReadOnlyMeta = "ReadOnlyTable";
 
 namespace {
@@ -80,42 +81,60 @@ static void MakeReadOnlyProxy(lua_State *L, int idx) {
 }
 
 // EnumItem methods
+enum class EnumItemMember { None, Value, Name };
+
+static AtomMap<EnumItemMember> s_enumItemMembers(EnumItemMember::None);
+
+static LuaEnumItem *CheckEnumItem(lua_State *L, int idx) {
+    LuaEnumItem *item = (LuaEnumItem *)lua_touserdatatagged(L, idx, kEnumItemTag);
+    if (!item) luaL_typeerror(L, idx, "EnumItem");
+    return item;
+}
+
 static int EnumItem_tostring(lua_State *L) {
-    LuaEnumItem *item = (LuaEnumItem *)luaL_checkudata(L, 1, kEnumItemMeta);
+    LuaEnumItem *item = CheckEnumItem(L, 1);
     lua_pushfstring(L, "Enum.%s.%s", item->enumName, item->itemName);
     return 1;
 }
 
 static int EnumItem_index(lua_State *L) {
-    LuaEnumItem *item = (LuaEnumItem *)luaL_checkudata(L, 1, kEnumItemMeta);
-    const char *key = luaL_checkstring(L, 2);
-    if (strcmp(key, "Value") == 0) {
+    LuaEnumItem *item = CheckEnumItem(L, 1);
+    int atom = LuaAtoms::None;
+    const char *key = lua_tostringatom(L, 2, &atom);
+    if (!key) luaL_typeerror(L, 2, "string");
+    switch (s_enumItemMembers.Find(atom, key)) {
+    case EnumItemMember::Value:
         lua_pushinteger(L, item->value);
         return 1;
-    }
-    if (strcmp(key, "Name") == 0) {
+    case EnumItemMember::Name:
         lua_pushstring(L, item->itemName);
         return 1;
+    default:
+        lua_pushnil(L);
+        return 1;
     }
-    lua_pushnil(L);
-    return 1;
 }
 
 static void EnsureEnumItemMetatable(lua_State *L) {
-    if (luaL_newmetatable(L, kEnumItemMeta)) {
-        lua_pushcfunction(L, EnumItem_index, "__index");
-        lua_setfield(L, -2, "__index");
-        lua_pushcfunction(L, EnumItem_tostring, "__tostring");
-        lua_setfield(L, -2, "__tostring");
-    }
+    lua_getuserdatametatable(L, kEnumItemTag);
+    bool exists = !lua_isnil(L, -1);
     lua_pop(L, 1);
+    if (exists) return;
+
+    s_enumItemMembers.Add("Value", EnumItemMember::Value);
+    s_enumItemMembers.Add("Name", EnumItemMember::Name);
+
+    lua_newtable(L);
+    lua_pushcfunction(L, EnumItem_index, "__index");
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, EnumItem_tostring, "__tostring");
+    lua_setfield(L, -2, "__tostring");
+    lua_setuserdatametatable(L, kEnumItemTag); // pops the metatable
 }
 
 int TryGetEnumItem(lua_State *L, int idx, const char **outEnumName,
                    const char **outItemName, int *outValue) {
-    if (!lua_isuserdata(L, idx)) return 0;
-    // luaL_testudata isn't available; use lua_getmetatable + compare
-    LuaEnumItem *p = (LuaEnumItem *)luaL_checkudata(L, idx, kEnumItemMeta);
+    LuaEnumItem *p = (LuaEnumItem *)lua_touserdatatagged(L, idx, kEnumItemTag);
     if (!p) return 0;
     if (outEnumName) *outEnumName = p->enumName;
     if (outItemName) *outItemName = p->itemName;
@@ -126,12 +145,11 @@ int TryGetEnumItem(lua_State *L, int idx, const char **outEnumName,
 static void PushEnumItem(lua_State *L, const char *enumName,
                          const char *itemName, int value) {
     EnsureEnumItemMetatable(L);
-    LuaEnumItem *ud = (LuaEnumItem *)lua_newuserdata(L, sizeof(LuaEnumItem));
+    LuaEnumItem *ud = (LuaEnumItem *)lua_newuserdatataggedwithmetatable(
+        L, sizeof(LuaEnumItem), kEnumItemTag);
     ud->enumName = enumName;
     ud->itemName = itemName;
     ud->value = value;
-    luaL_getmetatable(L, kEnumItemMeta);
-    lua_setmetatable(L, -2);
 }
 
 EnumRegistrar::EnumRegistrar(EnumRegisterFunc func) {
@@ -0,0 +1,47 @@
+#include "InstanceTable.h"
+
+uint32_t InstanceTable::freeHead = InstanceHandle::NoSlot;
+size_t InstanceTable::liveCount = 0;
+
+std::vector<InstanceTable::Entry> &InstanceTable::Entries() {
+    static auto *entries = new std::vector<Entry>();
+    return *entries;
+}
+
+InstanceHandle InstanceTable::Register(Instance *inst) {
+    auto &entries = Entries();
+
+    uint32_t slot;
+    if (freeHead != InstanceHandle::NoSlot) {
+        slot = freeHead;
+        freeHead = entries[slot].NextFree;
+    } else {
+        slot = (uint32_t)entries.size();
+        entries.emplace_back();
+    }
+
+    Entry &entry = entries[slot];
+    entry.Inst = inst;
+    entry.NextFree = InstanceHandle::NoSlot;
+    ++liveCount;
+
+    return InstanceHandle{slot, entry.Generation};
+}
+
+void InstanceTable::Unregister(InstanceHandle handle) {
+    auto &entries = Entries();
+    if (handle.Slot >= entries.size())
+        return;
+
+    Entry &entry = entries[handle.Slot];
+    if (entry.Generation != handle.Generation)
+        return;
+
+    entry.Inst = nullptr;
+    // Skip 0 on wrap-around so a zeroed handle never resolves
+    if (++entry.Generation == 0)
+        entry.Generation = 1;
+    entry.NextFree = freeHead;
+    freeHead = handle.Slot;
+    --liveCount;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Instance;
+
+// Lua-facing reference to an instance. Resolves through InstanceTable rather
+// than pointing at the instance, so a handle that outlives its instance is
+// detected instead of dereferencing freed (possibly recycled) memory.
+struct InstanceHandle {
+    static constexpr uint32_t NoSlot = UINT32_MAX;
+
+    uint32_t Slot = NoSlot;
+    uint32_t Generation = 0;
+
+    bool operator==(const InstanceHandle &other) const {
+        return Slot == other.Slot && Generation == other.Generation;
+    }
+    bool operator!=(const InstanceHandle &other) const {
+        return !(*this == other);
+    }
+};
+
+// Slot table behind InstanceHandle. Every live instance owns one slot.
+// Unregistering bumps the slot's generation and puts it on a free list, so
+// old handles stop resolving and the slot is reused by the next instance.
+class InstanceTable {
+private:
+    struct Entry {
+        Instance *Inst = nullptr;
+        uint32_t Generation = 1;
+        uint32_t NextFree = InstanceHandle::NoSlot;
+    };
+
+    // Leaked so instances freed during static teardown can still unregister
+    static std::vector<Entry> &Entries();
+    static uint32_t freeHead;
+    static size_t liveCount;
+
+public:
+    static InstanceHandle Register(Instance *inst);
+    static void Unregister(InstanceHandle handle);
+
+    // nullptr when the handle's instance has been freed
+    static Instance *Resolve(InstanceHandle handle) {
+        const auto &entries = Entries();
+        if (handle.Slot >= entries.size())
+            return nullptr;
+        const Entry &entry = entries[handle.Slot];
+        return entry.Generation == handle.Generation ? entry.Inst : nullptr;
+    }
+
+    // Calls fn with every live instance, in slot order. fn must not create or
+    // free instances.
+    template <typename Fn> static void ForEachLive(Fn fn) {
+        for (const Entry &entry : Entries())
+            if (entry.Inst)
+                fn(entry.Inst);
+    }
+
+    static size_t GetLiveCount() { return liveCount; }
+    static size_t GetSlotCount() { return Entries().size(); }
+};
@@ -0,0 +1,64 @@
+#include "InternedString.h"
+#include <unordered_map>
+
+#if LEMON_INTERN_STRINGS
+
+// Leaked, so handles in static objects can still release during teardown.
+// Node-based map: entry addresses stay valid across rehashes.
+static std::unordered_map<std::string, size_t> &Table() {
+    static auto *table = new std::unordered_map<std::string, size_t>();
+    return *table;
+}
+
+InternedString::Entry *InternedString::Intern(const std::string &str) {
+    Entry &entry = *Table().emplace(str, 0).first;
+    ++entry.second;
+    return &entry;
+}
+
+void InternedString::Free(Entry *entry) { Table().erase(entry->first); }
+
+InternedString::InternedString() {
+    // Held forever: the empty string is every default handle
+    static Entry *empty = Intern(std::string());
+    entry = empty;
+    ++entry->second;
+}
+
+bool InternedString::Find(const std::string &str, InternedString &out) {
+    auto &table = Table();
+    auto it = table.find(str);
+    if (it == table.end())
+        return false;
+    ++it->second;
+    out.Release();
+    out.entry = &*it;
+    return true;
+}
+
+size_t InternedString::Count() { return Table().size(); }
+
+#else
+
+static size_t s_count = 0;
+
+InternedString::Entry *InternedString::Intern(const std::string &str) {
+    ++s_count;
+    return new Entry(str, 1);
+}
+
+void InternedString::Free(Entry *entry) {
+    --s_count;
+    delete entry;
+}
+
+InternedString::InternedString() : entry(Intern(std::string())) {}
+
+bool InternedString::Find(const std::string &str, InternedString &out) {
+    out = InternedString(str);
+    return true;
+}
+
+size_t InternedString::Count() { return s_count; }
+
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "Config.h"
+
+// Handle to a string stored once in a process-wide table. Copies share one
+// entry and equality between two handles is a pointer compare. Entries are
+// reference counted and freed with their last handle, so a stream of unique
+// names ("Enemy" .. id) does not grow the table.
+//
+// Built with LEMON_INTERN_STRINGS=0, every handle owns a private copy and
+// compares by content: the plain std::string baseline, for benchmarks.
+class InternedString {
+private:
+    // Text and the number of handles referring to it
+    using Entry = std::pair<const std::string, size_t>;
+
+    Entry *entry;
+
+    static Entry *Intern(const std::string &str);
+    static void Free(Entry *entry);
+
+    void Release() {
+        if (--entry->second == 0)
+            Free(entry);
+    }
+
+public:
+    InternedString();
+    InternedString(const std::string &str) : entry(Intern(str)) {}
+    InternedString(const char *str) : entry(Intern(str)) {}
+
+#if LEMON_INTERN_STRINGS
+    InternedString(const InternedString &other) : entry(other.entry) {
+        ++entry->second;
+    }
+    InternedString &operator=(const InternedString &other) {
+        ++other.entry->second;
+        Release();
+        entry = other.entry;
+        return *this;
+    }
+#else
+    InternedString(const InternedString &other) : entry(Intern(other.str())) {}
+    InternedString &operator=(const InternedString &other) {
+        if (this != &other) {
+            Entry *copy = Intern(other.str());
+            Release();
+            entry = copy;
+        }
+        return *this;
+    }
+#endif
+
+    ~InternedString() { Release(); }
+
+    // Look up an already interned string without adding it. Returns false
+    // when str was never interned, meaning no handle can compare equal to it.
+    static bool Find(const std::string &str, InternedString &out);
+
+    // Number of distinct strings in the table
+    static size_t Count();
+
+    const std::string &str() const { return entry->first; }
+    const char *c_str() const { return entry->first.c_str(); }
+    size_t size() const { return entry->first.size(); }
+    bool empty() const { return entry->first.empty(); }
+
+    operator const std::string &() const { return entry->first; }
+
+#if LEMON_INTERN_STRINGS
+    bool operator==(const InternedString &other) const {
+        return entry == other.entry;
+    }
+#else
+    bool operator==(const InternedString &other) const {
+        return entry->first == other.entry->first;
+    }
+#endif
+    bool operator!=(const InternedString &other) const {
+        return !(*this == other);
+    }
+
+    // Content compares for callers holding plain strings
+    bool operator==(const std::string &other) const {
+        return entry->first == other;
+    }
+    bool operator!=(const std::string &other) const {
+        return entry->first != other;
+    }
+    bool operator==(const char *other) const { return entry->first == other; }
+    bool operator!=(const char *other) const { return entry->first != other; }
+
+    struct Hash {
+        size_t operator()(const InternedString &str) const {
+#if LEMON_INTERN_STRINGS
+            return std::hash<const Entry *>()(str.entry);
+#else
+            return std::hash<std::string>()(str.entry->first);
+#endif
+        }
+    };
+};
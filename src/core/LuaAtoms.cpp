@@ -0,0 +1,53 @@
+#include "LuaAtoms.h"
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+// Leaked: the map's keys view into names, which must never move
+std::deque<std::string> &Names() {
+    static auto *names = new std::deque<std::string>();
+    return *names;
+}
+
+std::unordered_map<std::string_view, int16_t> &Ids() {
+    static auto *ids = new std::unordered_map<std::string_view, int16_t>();
+    return *ids;
+}
+
+int16_t UserAtom(const char *s, size_t l) {
+    return LuaAtoms::Find(std::string_view(s, l));
+}
+
+} // namespace
+
+int16_t LuaAtoms::Register(std::string_view name) {
+    auto &ids = Ids();
+    auto it = ids.find(name);
+    if (it != ids.end())
+        return it->second;
+
+    if (ids.size() >= INT16_MAX) {
+        printf("WARNING: out of Lua atoms, '%.*s' dispatches by name\n",
+               (int)name.size(), name.data());
+        return None;
+    }
+
+    const std::string &stored = Names().emplace_back(name);
+    int16_t atom = (int16_t)ids.size();
+    ids.emplace(stored, atom);
+    return atom;
+}
+
+int16_t LuaAtoms::Find(std::string_view name) {
+    const auto &ids = Ids();
+    auto it = ids.find(name);
+    return it == ids.end() ? None : it->second;
+}
+
+int16_t LuaAtoms::Count() { return (int16_t)Ids().size(); }
+
+void LuaAtoms::Install(lua_State *L) { lua_callbacks(L)->useratom = UserAtom; }
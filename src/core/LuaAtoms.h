@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../../luau/VM/include/lua.h"
+
+// Small integer ids for names the engine dispatches on. Luau asks for a
+// string's atom once, when it interns the string, so code holding a
+// __namecall name (lua_namecallatom) or a key string (lua_tostringatom) can
+// index an array instead of hashing or comparing text.
+//
+// Only names registered before a string is interned get an atom; strings
+// created earlier report None and must take a name-based fallback.
+class LuaAtoms {
+public:
+    static constexpr int16_t None = -1;
+
+    // Idempotent. Returns the name's atom.
+    static int16_t Register(std::string_view name);
+
+    // None when the name was never registered
+    static int16_t Find(std::string_view name);
+
+    // Number of atoms handed out so far; atoms are [0, Count())
+    static int16_t Count();
+
+    // Install the useratom callback on the VM
+    static void Install(lua_State *L);
+};
+
+// Maps member names to a caller's enum through their atoms, for __index and
+// __namecall handlers that switch on the member. Names whose string was
+// interned without an atom are looked up by text instead.
+template <typename Member> class AtomMap {
+private:
+    std::vector<Member> byAtom;
+    Member none;
+
+public:
+    explicit AtomMap(Member none) : none(none) {}
+
+    void Add(std::string_view name, Member member) {
+        int16_t atom = LuaAtoms::Register(name);
+        if (atom == LuaAtoms::None)
+            return;
+        if (byAtom.size() <= (size_t)atom)
+            byAtom.resize(atom + 1, none);
+        byAtom[atom] = member;
+    }
+
+    Member Find(int atom, const char *name) const {
+        if (atom < 0 && name)
+            atom = LuaAtoms::Find(name);
+        if (atom < 0 || (size_t)atom >= byAtom.size())
+            return none;
+        return byAtom[atom];
+    }
+};
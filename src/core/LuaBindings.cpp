@@ -2,7 +2,9 @@
 #include "../datatypes/Color3.h"
 #include "../datatypes/Vector3.h"
 #include "./EnumRegistry.h"
+#include "Config.h"
 
+#include "../instances/CollectionService.h"
 #include "../instances/DataModel.h"
 #include "../instances/LuaSourceContainer.h"
 #include "../instances/ModuleScript.h"
@@ -11,11 +13,27 @@
 #include "../instances/ServiceProvider.h"
 #include "../instances/Workspace.h"
 
+#include "LuaAtoms.h"
 #include "LuaClassBinder.h"
+#include "MemoryStats.h"
 
 // Legacy signal binding (keep for now)
+
+// A signal that belongs to an instance is only valid while its owner is
+struct SignalUserdata {
+    Signal *signal;
+    InstanceHandle owner;
+};
+
+static Signal *CheckSignal(lua_State *L, int idx) {
+    auto *udata = (SignalUserdata *)luaL_checkudata(L, idx, "Signal");
+    if (udata->owner.Slot != InstanceHandle::NoSlot &&
+        !InstanceTable::Resolve(udata->owner))
+        luaL_error(L, "instance destroyed");
+    return udata->signal;
+}
 static int l_Signal_Connect(lua_State *L) {
-    Signal *sig = *(Signal **)luaL_checkudata(L, 1, "Signal");
+    Signal *sig = CheckSignal(L, 1);
     luaL_checktype(L, 2, LUA_TFUNCTION);
 
     sig->ConnectLua(L, 2);
@@ -23,7 +41,7 @@ static int l_Signal_Connect(lua_State *L) {
 }
 
 static int l_Signal_Fire(lua_State *L) {
-    Signal *sig = *(Signal **)luaL_checkudata(L, 1, "Signal");
+    Signal *sig = CheckSignal(L, 1);
 
     Instance *inst = nullptr;
     if (lua_isuserdata(L, 2)) {
@@ -35,11 +53,19 @@ static int l_Signal_Fire(lua_State *L) {
 }
 
 static int l_Signal_DisconnectAll(lua_State *L) {
-    Signal *sig = *(Signal **)luaL_checkudata(L, 1, "Signal");
+    Signal *sig = CheckSignal(L, 1);
     sig->DisconnectAll();
     return 0;
 }
 
+void Lua_PushSignal(lua_State *L, Signal *signal, Instance *owner) {
+    auto *udata = (SignalUserdata *)lua_newuserdata(L, sizeof(SignalUserdata));
+    udata->signal = signal;
+    udata->owner = owner ? owner->Handle : InstanceHandle{};
+    luaL_getmetatable(L, "Signal");
+    lua_setmetatable(L, -2);
+}
+
 void Lua_RegisterSignal(lua_State *L) {
     luaL_newmetatable(L, "Signal");
 
@@ -84,15 +110,58 @@ int Lua_SetCameraPos(lua_State *L) {
     return 0;
 }
 
+int Lua_GetMemoryUsage(lua_State *L) {
+    lua_pushnumber(L, (double)GetResidentMemoryBytes());
+    return 1;
+}
+
+int Lua_GetInstanceCount(lua_State *L) {
+    lua_pushnumber(L, (double)Instance::GetLiveCount());
+    return 1;
+}
+
+int Lua_GetInternedStringCount(lua_State *L) {
+    lua_pushnumber(L, (double)InternedString::Count());
+    return 1;
+}
+
+// Compile-time switches, so benchmarks can label which baseline they ran
+int Lua_GetBuildOptions(lua_State *L) {
+    lua_createtable(L, 0, 2);
+    lua_pushboolean(L, LEMON_INTERN_STRINGS);
+    lua_setfield(L, -2, "InternStrings");
+    lua_pushboolean(L, LEMON_POOLED_ALLOCATION);
+    lua_setfield(L, -2, "PooledAllocation");
+    return 1;
+}
+
+int Lua_GetRenderedPartCount(lua_State *L) {
+    lua_pushnumber(L, g_instances ? (double)g_instances->size() : 0);
+    return 1;
+}
+
 void RegisterScriptBindings(lua_State *L, std::vector<BasePart *> &parts,
                             Camera3D &g_camera) {
     g_instances = &parts;
     gg_camera = &g_camera;
 
+    // Before anything below interns the names it dispatches on
+    LuaAtoms::Install(L);
+
     // Create Engine table
     lua_newtable(L);
     lua_pushcfunction(L, Lua_SetCameraPos, "SetCameraPos");
     lua_setfield(L, -2, "SetCameraPos");
+    lua_pushcfunction(L, Lua_GetMemoryUsage, "GetMemoryUsage");
+    lua_setfield(L, -2, "GetMemoryUsage");
+    lua_pushcfunction(L, Lua_GetInstanceCount, "GetInstanceCount");
+    lua_setfield(L, -2, "GetInstanceCount");
+    lua_pushcfunction(L, Lua_GetRenderedPartCount, "GetRenderedPartCount");
+    lua_setfield(L, -2, "GetRenderedPartCount");
+    lua_pushcfunction(L, Lua_GetBuildOptions, "GetBuildOptions");
+    lua_setfield(L, -2, "GetBuildOptions");
+    lua_pushcfunction(L, Lua_GetInternedStringCount, "GetInternedStringCount");
+    lua_setfield(L, -2, "GetInternedStringCount");
     lua_setglobal(L, "Engine");
 
     // Register Enums
@@ -118,6 +187,7 @@ void RegisterScriptBindings(lua_State *L, std::vector<BasePart *> &parts,
         L); // Creates 'game' global (DataModel inherits from ServiceProvider)
     Workspace::Bind(
         L); // Creates 'workspace' global (Workspace inherits from Instance)
+    CollectionService::Bind(L); // CollectionService inherits from Instance
 
     // Register signals
     Lua_RegisterSignal(L);
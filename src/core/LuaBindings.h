@@ -29,9 +29,19 @@ extern Camera3D *gg_camera;
 
 int Lua_SpawnPart(lua_State *L);
 int Lua_SetCameraPos(lua_State *L);
+int Lua_GetMemoryUsage(lua_State *L);
+int Lua_GetInstanceCount(lua_State *L);
+int Lua_GetRenderedPartCount(lua_State *L);
+int Lua_GetBuildOptions(lua_State *L);
+int Lua_GetInternedStringCount(lua_State *L);
 
 void RegisterScriptBindings(lua_State *L, std::vector<BasePart *> &parts,
                             Camera3D &g_camera);
 } // namespace LuaBindings
 
-int Lua_UserdataPtrEq(lua_State *L);
\ No newline at end of file
+int Lua_UserdataPtrEq(lua_State *L);
+
+// Push a Signal as a "Signal" userdata (Connect, Fire, DisconnectAll).
+// When the signal is a member of an instance, pass it as owner so uses
+// after the owner is freed raise "instance destroyed".
+void Lua_PushSignal(lua_State *L, Signal *signal, Instance *owner = nullptr);
\ No newline at end of file
@@ -4,27 +4,92 @@
 #include "../instances/BasePart.h"
 #include "../instances/Instance.h"
 #include "../instances/Part.h"
+#include "LuaTags.h"
+#include "PropertyReflection.h"
 #include <unordered_set>
 
 std::unordered_map<std::string, ClassDescriptor> LuaClassBinder::s_classes;
+std::vector<std::pair<std::string, lua_CFunction>>
+    LuaClassBinder::s_staticFunctions;
+std::vector<DispatchTable> LuaClassBinder::s_dispatch;
+
+// Registry field pinning every member name string, so their addresses stay
+// valid as dispatch keys
+static const char *kDispatchKeysKey = "DispatchKeys";
+
+static size_t HashKey(const char *key) {
+    // Luau strings are at least 8-byte aligned; mix the remaining bits
+    return (size_t)(((uintptr_t)key >> 3) * 0x9E3779B97F4A7C15ull >> 32);
+}
+
+void DispatchTable::Build(const std::vector<DispatchEntry> &entries) {
+    size_t capacity = 8;
+    while (capacity < entries.size() * 2)
+        capacity *= 2;
+
+    slots.assign(capacity, DispatchEntry{});
+    mask = capacity - 1;
+    lastHit = nullptr;
+    methodsByAtom.assign(LuaAtoms::Count(), nullptr);
+
+    for (const DispatchEntry &entry : entries) {
+        size_t i = HashKey(entry.key) & mask;
+        while (slots[i].key)
+            i = (i + 1) & mask;
+        slots[i] = entry;
+
+        if (entry.method && entry.atom != LuaAtoms::None)
+            methodsByAtom[entry.atom] = entry.method;
+    }
+}
+
+const DispatchEntry *DispatchTable::Find(const char *key) const {
+    if (lastHit && lastHit->key == key)
+        return lastHit;
+    if (slots.empty())
+        return nullptr;
+
+    for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+        const DispatchEntry &slot = slots[i];
+        if (slot.key == key) {
+            lastHit = &slot;
+            return &slot;
+        }
+        if (!slot.key)
+            return nullptr;
+    }
+}
+
+// Registry field holding the userdata cache: a weak-valued array indexed by
+// InstanceTable slot + 1
+static const char *kInstanceCacheKey = "InstanceCache";
 
 void LuaClassBinder::RegisterClass(const std::string &className,
                                    const std::string &parentClassName) {
+    ClassRegistry::Register(className, parentClassName);
+
     ClassDescriptor desc;
     desc.className = className;
     desc.parentClassName = parentClassName;
+    desc.classId = ClassRegistry::GetClassId(className);
     s_classes[className] = desc;
 }
 
 void LuaClassBinder::AddProperty(const std::string &className,
                                  const std::string &propName,
                                  PropertyGetter getter, PropertySetter setter) {
+    PropertyDescriptor prop;
+    prop.getter = getter;
+    prop.setter = setter;
+    prop.readonly = (setter == nullptr);
+    AddPropertyDescriptor(className, propName, prop);
+}
+
+void LuaClassBinder::AddPropertyDescriptor(const std::string &className,
+                                           const std::string &propName,
+                                           const PropertyDescriptor &prop) {
     auto it = s_classes.find(className);
     if (it != s_classes.end()) {
-        PropertyDescriptor prop;
-        prop.getter = getter;
-        prop.setter = setter;
-        prop.readonly = (setter == nullptr);
         it->second.properties[propName] = prop;
     }
 }
@@ -46,32 +111,79 @@ void LuaClassBinder::SetConstructor(const std::string &className,
     }
 }
 
+// nullptr unless the value at idx is instance userdata
+static InstanceHandle *ToInstanceHandle(lua_State *L, int idx) {
+    return (InstanceHandle *)lua_touserdatatagged(L, idx, kInstanceTag);
+}
+
 bool LuaClassBinder::IsA(lua_State *L, int idx, const std::string &className) {
-    if (!lua_isuserdata(L, idx))
+    InstanceHandle *handle = ToInstanceHandle(L, idx);
+    Instance *inst = handle ? InstanceTable::Resolve(*handle) : nullptr;
+    if (!inst)
         return false;
 
-    Instance **pinst = (Instance **)lua_touserdata(L, idx);
-    if (!pinst || !*pinst)
-        return false;
+    return inst->IsA(className);
+}
 
-    return (*pinst)->IsA(className);
+Instance *LuaClassBinder::CheckInstance(lua_State *L, int idx) {
+    static const ClassId instanceClassId =
+        ClassRegistry::GetClassId(Instance::StaticClassName);
+    return CheckInstance(L, idx, instanceClassId);
 }
 
 Instance *LuaClassBinder::CheckInstance(lua_State *L, int idx,
                                         const std::string &className) {
-    Instance **pinst = (Instance **)lua_touserdata(L, idx);
-    if (!pinst || !*pinst) {
-        luaL_error(L, "Invalid instance pointer");
+    if (className.empty())
+        return CheckInstance(L, idx, kInvalidClassId);
+
+    ClassId classId = ClassRegistry::FindClassId(className);
+    if (classId == kInvalidClassId) {
+        luaL_error(L, "Unknown class '%s'", className.c_str());
         return nullptr;
     }
+    return CheckInstance(L, idx, classId);
+}
 
-    if (!className.empty() && !(*pinst)->IsA(className)) {
-        luaL_error(L, "Expected %s, got %s", className.c_str(),
-                   (*pinst)->ClassName.c_str());
+Instance *LuaClassBinder::CheckInstance(lua_State *L, int idx,
+                                        ClassId classId) {
+    InstanceHandle *handle = ToInstanceHandle(L, idx);
+    if (!handle) {
+        luaL_typeerror(L, idx,
+                       classId != kInvalidClassId
+                           ? ClassRegistry::GetClassName(classId).c_str()
+                           : "Instance");
         return nullptr;
     }
 
-    return *pinst;
+    Instance *inst = InstanceTable::Resolve(*handle);
+    if (!inst) {
+        luaL_error(L, "instance destroyed");
+        return nullptr;
+    }
+
+    if (classId != kInvalidClassId && !inst->IsA(classId)) {
+        luaL_error(L, "Expected %s, got %s",
+                   ClassRegistry::GetClassName(classId).c_str(),
+                   inst->ClassName.c_str());
+        return nullptr;
+    }
+
+    return inst;
+}
+
+std::vector<Instance *> LuaClassBinder::CheckInstanceList(lua_State *L,
+                                                          int idx) {
+    luaL_checktype(L, idx, LUA_TTABLE);
+
+    int count = lua_objlen(L, idx);
+    std::vector<Instance *> instances;
+    instances.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        lua_rawgeti(L, idx, i);
+        instances.push_back(CheckInstance(L, -1));
+        lua_pop(L, 1);
+    }
+    return instances;
 }
 
 void LuaClassBinder::PushInstance(lua_State *L, Instance *inst) {
@@ -80,107 +192,109 @@ void LuaClassBinder::PushInstance(lua_State *L, Instance *inst) {
         return;
     }
 
-    Instance **udata = (Instance **)lua_newuserdata(L, sizeof(Instance *));
-    *udata = inst;
+    // Hand out the userdata Lua already holds for this instance, so each
+    // instance has one Lua object and == is raw equality
+    const int slot = (int)inst->Handle.Slot + 1;
+    if (lua_rawgetfield(L, LUA_REGISTRYINDEX, kInstanceCacheKey) !=
+        LUA_TTABLE) {
+        lua_pop(L, 1);
+        lua_newtable(L);
+    }
+
+    // A cached userdata from a previous owner of the slot is stale
+    lua_rawgeti(L, -1, slot);
+    if (InstanceHandle *cached = ToInstanceHandle(L, -1);
+        cached && *cached == inst->Handle) {
+        lua_remove(L, -2);
+        return;
+    }
+    lua_pop(L, 1);
+
+    auto *udata = (InstanceHandle *)lua_newuserdatatagged(
+        L, sizeof(InstanceHandle), kInstanceTag);
+    *udata = inst->Handle;
 
     std::string metaName = GetMetatableName(inst->ClassName);
     luaL_getmetatable(L, metaName.c_str());
     lua_setmetatable(L, -2);
+
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, -3, slot);
+    lua_remove(L, -2);
 }
 
 int LuaClassBinder::MethodClosure(lua_State *L) {
-    // Get instance from upvalue (light userdata)
-    Instance *inst = (Instance *)lua_tolightuserdata(L, lua_upvalueindex(1));
+    // Get instance from upvalue (the userdata it was indexed on)
+    Instance *inst = CheckInstance(L, lua_upvalueindex(1), kInvalidClassId);
 
-    // Get method name from upvalue
-    const char *methodName = lua_tostring(L, lua_upvalueindex(2));
+    // Resolved when the method was indexed
+    auto *method =
+        (const MethodFunc *)lua_tolightuserdata(L, lua_upvalueindex(2));
+    return (*method)(L, inst);
+}
 
-    if (!inst) {
-        luaL_error(L, "Invalid instance in method call");
+int LuaClassBinder::GenericNamecall(lua_State *L) {
+    Instance *inst = CheckInstance(L, 1);
+
+    int atom = LuaAtoms::None;
+    const char *name = lua_namecallatom(L, &atom);
+    if (!name) {
+        luaL_error(L, "__namecall called without a method name");
+        return 0;
     }
 
-    // Find the method in the class hierarchy
-    std::string currentClass = inst->ClassName;
-    while (!currentClass.empty()) {
-        auto *desc = GetDescriptor(currentClass);
-        if (desc) {
-            auto it = desc->methods.find(methodName);
-            if (it != desc->methods.end()) {
-                return it->second(L, inst);
-            }
-            currentClass = desc->parentClassName;
-        } else {
-            break;
-        }
+    // Common case: the name was interned with its atom, and self stays at
+    // index 1 with the arguments after it, exactly as the method expects
+    if (s_dispatch.size() > inst->ClassIndex) {
+        if (const MethodFunc *method =
+                s_dispatch[inst->ClassIndex].FindMethod(atom))
+            return (*method)(L, inst);
     }
 
-    luaL_error(L, "Method '%s' not found on class '%s'", methodName,
+    // Name interned before its atom was registered, or not a method
+    const DispatchEntry *entry = FindMember(inst->ClassIndex, name);
+    if (entry && entry->getProperty) {
+        // inst:Prop(...) calls whatever the property holds
+        int nargs = lua_gettop(L);
+        entry->getProperty->getter(L, inst);
+        lua_insert(L, 1);
+        lua_call(L, nargs, LUA_MULTRET);
+        return lua_gettop(L);
+    }
+    if (entry && entry->method)
+        return (*entry->method)(L, inst);
+
+    luaL_error(L, "%s is not a valid member of %s", name,
                inst->ClassName.c_str());
+    return 0;
+}
+
+const DispatchEntry *LuaClassBinder::FindMember(ClassId classId,
+                                                const char *key) {
+    if (classId >= s_dispatch.size())
+        return nullptr;
+    return s_dispatch[classId].Find(key);
 }
 
 int LuaClassBinder::GenericIndex(lua_State *L) {
     Instance *inst = CheckInstance(L, 1);
     const char *key = luaL_checkstring(L, 2);
 
-    // todo: add some kind of lookup
-
-    // printf("GenericIndex called: object class='%s', looking for key='%s'\n",
-    //        inst->ClassName.c_str(), key);
-
-    // Walk up the inheritance chain
-    std::string currentClass = inst->ClassName;
-    std::vector<std::string> checked;
-
-    while (!currentClass.empty()) {
-        checked.push_back(currentClass);
-        auto *desc = GetDescriptor(currentClass);
-
-        if (!desc) {
-            printf("  WARNING: No descriptor found for class '%s'\n",
-                   currentClass.c_str());
-            break;
-        }
-
-        // printf("  Checking class '%s' (has %zu properties, %zu methods)\n",
-        //        currentClass.c_str(), desc->properties.size(),
-        //        desc->methods.size());
-
-        // Check properties FIRST
-        auto propIt = desc->properties.find(key);
-        if (propIt != desc->properties.end()) {
-            // printf("  FOUND property '%s' in class '%s'\n", key,
-            //        currentClass.c_str());
-            if (propIt->second.getter) {
-                return propIt->second.getter(L, inst);
-            } else {
-                printf("  WARNING: Property '%s' found but has no getter\n",
-                       key);
-            }
-        }
+    if (const DispatchEntry *entry = FindMember(inst->ClassIndex, key)) {
+        if (entry->getProperty)
+            return entry->getProperty->getter(L, inst);
 
-        // Check methods
-        auto methodIt = desc->methods.find(key);
-        if (methodIt != desc->methods.end()) {
-            // printf("  FOUND method '%s' in class '%s'\n", key,
-            //        currentClass.c_str());
-            // Push instance as light userdata
-            lua_pushlightuserdata(L, inst);
-            // Store method name
-            lua_pushstring(L, key);
-            // Create closure that will call the method
+        if (entry->method) {
+            // Keep the instance userdata; its handle is checked on each call
+            lua_pushvalue(L, 1);
+            lua_pushlightuserdata(L, (void *)entry->method);
             lua_pushcclosure(L, MethodClosure, "method", 2);
             return 1;
         }
-
-        currentClass = desc->parentClassName;
-        // printf("  Not found in '%s', moving to parent '%s'\n",
-        //        checked.back().c_str(), currentClass.c_str());
     }
 
-    printf("  Property/method '%s' not found in hierarchy: ", key);
-    for (const auto &c : checked)
-        printf("%s ", c.c_str());
-    printf("\n");
+    printf("  Property/method '%s' not found on class '%s'\n", key,
+           inst->ClassName.c_str());
 
     lua_pushnil(L);
     return 1;
@@ -190,25 +304,13 @@ int LuaClassBinder::GenericNewIndex(lua_State *L) {
     Instance *inst = CheckInstance(L, 1);
     const char *key = luaL_checkstring(L, 2);
 
-    // Walk up the inheritance chain
-    std::string currentClass = inst->ClassName;
-    while (!currentClass.empty()) {
-        auto *desc = GetDescriptor(currentClass);
-        if (!desc)
-            break;
-
-        auto propIt = desc->properties.find(key);
-        if (propIt != desc->properties.end()) {
-            if (propIt->second.readonly) {
-                luaL_error(L, "Property '%s' is readonly", key);
-                return 0;
-            }
-            if (propIt->second.setter) {
-                return propIt->second.setter(L, inst, 3);
-            }
+    const DispatchEntry *entry = FindMember(inst->ClassIndex, key);
+    if (entry && entry->setProperty) {
+        if (entry->setProperty->readonly) {
+            luaL_error(L, "Property '%s' is readonly", key);
+            return 0;
         }
-
-        currentClass = desc->parentClassName;
+        return entry->setProperty->setter(L, inst, 3);
     }
 
     luaL_error(L, "Unknown property '%s'", key);
@@ -216,23 +318,16 @@ int LuaClassBinder::GenericNewIndex(lua_State *L) {
 }
 
 int LuaClassBinder::GenericToString(lua_State *L) {
-    Instance *inst = CheckInstance(L, 1);
+    InstanceHandle *handle = ToInstanceHandle(L, 1);
+    Instance *inst = handle ? InstanceTable::Resolve(*handle) : nullptr;
+    if (!inst) {
+        lua_pushstring(L, "<destroyed instance>");
+        return 1;
+    }
     lua_pushfstring(L, "%s: %s", inst->ClassName.c_str(), inst->Name.c_str());
     return 1;
 }
 
-int LuaClassBinder::GenericEq(lua_State *L) {
-    Instance *a = CheckInstance(L, 1);
-    Instance *b = CheckInstance(L, 2);
-    lua_pushboolean(L, a == b);
-    return 1;
-}
-
-int LuaClassBinder::GenericGC(lua_State *L) {
-    // Don't delete instances here - they're managed elsewhere
-    return 0;
-}
-
 int LuaClassBinder::GenericConstructor(lua_State *L) {
     const char *className = luaL_checkstring(L, 1);
 
@@ -270,15 +365,12 @@ void LuaClassBinder::CreateMetatable(lua_State *L,
     lua_pushcfunction(L, GenericNewIndex, "__newindex");
     lua_setfield(L, -2, "__newindex");
 
+    lua_pushcfunction(L, GenericNamecall, "__namecall");
+    lua_setfield(L, -2, "__namecall");
+
     lua_pushcfunction(L, GenericToString, "__tostring");
     lua_setfield(L, -2, "__tostring");
 
-    lua_pushcfunction(L, GenericEq, "__eq");
-    lua_setfield(L, -2, "__eq");
-
-    lua_pushcfunction(L, GenericGC, "__gc");
-    lua_setfield(L, -2, "__gc");
-
     // Set parent metatable for inheritance
     auto *desc = GetDescriptor(className);
     if (desc && !desc->parentClassName.empty()) {
@@ -298,6 +390,11 @@ void LuaClassBinder::CreateMetatable(lua_State *L,
     lua_pop(L, 1);
 }
 
+void LuaClassBinder::AddStaticFunction(const std::string &name,
+                                       lua_CFunction fn) {
+    s_staticFunctions.emplace_back(name, fn);
+}
+
 void LuaClassBinder::BindAll(lua_State *L) {
     printf("=== LuaClassBinder::BindAll starting ===\n");
     printf("Total classes registered: %zu\n", s_classes.size());
@@ -341,12 +438,95 @@ void LuaClassBinder::BindAll(lua_State *L) {
         }
     }
 
+    BuildDispatchTables(L);
+    PropertyReflection::Build(s_classes);
+
+    // Weak values: an entry lives only as long as Lua references the
+    // userdata, after which the next push creates a fresh one
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+    lua_setfield(L, LUA_REGISTRYINDEX, kInstanceCacheKey);
+
     // Create Instance.new()
     printf("Creating Instance.new() constructor\n");
     lua_newtable(L);
     lua_pushcfunction(L, GenericConstructor, "new");
     lua_setfield(L, -2, "new");
+    for (const auto &[name, fn] : s_staticFunctions) {
+        lua_pushcfunction(L, fn, name.c_str());
+        lua_setfield(L, -2, name.c_str());
+    }
     lua_setglobal(L, "Instance");
 
     printf("=== LuaClassBinder::BindAll complete ===\n");
-}
\ No newline at end of file
+}
+
+void LuaClassBinder::BuildDispatchTables(lua_State *L) {
+    // Interning the names here and keeping them referenced means any Lua
+    // string with the same text is the same object, at the same address
+    lua_newtable(L);
+    int pinnedCount = 0;
+    std::unordered_map<std::string, const char *> pinned;
+    auto pin = [&](const std::string &name) {
+        auto it = pinned.find(name);
+        if (it != pinned.end())
+            return it->second;
+
+        lua_pushlstring(L, name.data(), name.size());
+        const char *key = lua_tostring(L, -1);
+        lua_rawseti(L, -2, ++pinnedCount);
+        pinned.emplace(name, key);
+        return key;
+    };
+
+    // Method names need their atoms before pin interns them
+    for (const auto &[className, desc] : s_classes)
+        for (const auto &[name, method] : desc.methods)
+            LuaAtoms::Register(name);
+
+    s_dispatch.clear();
+    for (const auto &[className, desc] : s_classes) {
+        if (desc.classId == kInvalidClassId)
+            continue;
+
+        // Walk from the class up, so the nearest definition wins. At each
+        // level properties shadow methods for reads, as GenericIndex always
+        // did; writes only ever consider properties.
+        std::unordered_map<std::string, DispatchEntry> members;
+        for (const ClassDescriptor *level = &desc; level;
+             level = level->parentClassName.empty()
+                         ? nullptr
+                         : GetDescriptor(level->parentClassName)) {
+            for (const auto &[name, prop] : level->properties) {
+                DispatchEntry &entry = members[name];
+                if (!entry.getProperty && !entry.method && prop.getter)
+                    entry.getProperty = &prop;
+                if (!entry.setProperty)
+                    entry.setProperty = &prop;
+            }
+            for (const auto &[name, method] : level->methods) {
+                DispatchEntry &entry = members[name];
+                if (!entry.getProperty && !entry.method)
+                    entry.method = &method;
+            }
+        }
+
+        std::vector<DispatchEntry> entries;
+        entries.reserve(members.size());
+        for (auto &[name, entry] : members) {
+            entry.key = pin(name);
+            if (entry.method)
+                entry.atom = LuaAtoms::Find(name);
+            entries.push_back(entry);
+        }
+
+        if (s_dispatch.size() <= desc.classId)
+            s_dispatch.resize(desc.classId + 1);
+        s_dispatch[desc.classId].Build(entries);
+    }
+
+    lua_setfield(L, LUA_REGISTRYINDEX, kDispatchKeysKey);
+}
@@ -2,6 +2,9 @@
 
 #include "../../luau/VM/include/lua.h"
 #include "../../luau/VM/include/lualib.h"
+#include "ClassRegistry.h"
+#include "LuaAtoms.h"
+#include "LuaField.h"
 #include <functional>
 #include <string>
 #include <unordered_map>
@@ -10,40 +13,92 @@
 // Forward declarations
 struct Instance;
 
-// Property accessor types
-using PropertyGetter = std::function<int(lua_State *, Instance *)>;
-using PropertySetter =
-    std::function<int(lua_State *, Instance *, int)>; // int is value index
+// Property accessor types. Plain function pointers: bindings are
+// captureless lambdas, so there is nothing to type-erase.
+using PropertyGetter = int (*)(lua_State *, Instance *);
+using PropertySetter = int (*)(lua_State *, Instance *,
+                               int); // int is value index
 
 // Method type
-using MethodFunc = std::function<int(lua_State *, Instance *)>;
+using MethodFunc = int (*)(lua_State *, Instance *);
 
 struct PropertyDescriptor {
-    PropertyGetter getter;
-    PropertySetter setter;
+    PropertyGetter getter = nullptr;
+    PropertySetter setter = nullptr;
     bool readonly = false;
+    // Set for properties bound with AddField, so serializers can copy the
+    // member directly. fieldOffset measures the member's offset from the
+    // start of the Instance on a live instance of the class.
+    FieldType fieldType = FieldType::None;
+    size_t (*fieldOffset)(const Instance *inst) = nullptr;
 };
 
 struct ClassDescriptor {
     std::string className;
     std::string parentClassName;
+    ClassId classId = kInvalidClassId;
     std::unordered_map<std::string, PropertyDescriptor> properties;
     std::unordered_map<std::string, MethodFunc> methods;
     std::function<Instance *()> constructor = nullptr;
 };
 
+// One member as seen from a class, after inheritance is resolved
+struct DispatchEntry {
+    // Address of the pinned Luau string holding the member name
+    const char *key = nullptr;
+    // What a read resolves to: a property with a getter, or a method
+    const PropertyDescriptor *getProperty = nullptr;
+    const MethodFunc *method = nullptr;
+    // What a write resolves to: the nearest property of that name
+    const PropertyDescriptor *setProperty = nullptr;
+    // Atom of the name when it is a method, for __namecall
+    int16_t atom = LuaAtoms::None;
+};
+
+// Flattened, immutable member table for one class, built by BindAll. Keys
+// are Luau string addresses: member names are interned and pinned, so a key
+// string with the same text has the same address and any other address is
+// not a member. Open addressing, plus a one-entry cache of the last hit.
+// Methods are also indexed by name atom, for __namecall.
+class DispatchTable {
+private:
+    std::vector<DispatchEntry> slots;
+    size_t mask = 0;
+    mutable const DispatchEntry *lastHit = nullptr;
+    std::vector<const MethodFunc *> methodsByAtom;
+
+public:
+    void Build(const std::vector<DispatchEntry> &entries);
+    const DispatchEntry *Find(const char *key) const;
+
+    const MethodFunc *FindMethod(int atom) const {
+        if (atom < 0 || (size_t)atom >= methodsByAtom.size())
+            return nullptr;
+        return methodsByAtom[atom];
+    }
+};
+
 class LuaClassBinder {
 private:
     static std::unordered_map<std::string, ClassDescriptor> s_classes;
+    static std::vector<std::pair<std::string, lua_CFunction>>
+        s_staticFunctions;
+    // Indexed by ClassId
+    static std::vector<DispatchTable> s_dispatch;
 
     static int GenericIndex(lua_State *L);
     static int GenericNewIndex(lua_State *L);
+    static int GenericNamecall(lua_State *L);
     static int GenericToString(lua_State *L);
-    static int GenericEq(lua_State *L);
-    static int GenericGC(lua_State *L);
     static int GenericConstructor(lua_State *L);
     static int MethodClosure(lua_State *L);
 
+    static void BuildDispatchTables(lua_State *L);
+
+    static void AddPropertyDescriptor(const std::string &className,
+                                      const std::string &propName,
+                                      const PropertyDescriptor &prop);
+
     static std::string GetMetatableName(const std::string &className);
     static void CreateMetatable(lua_State *L, const std::string &className);
 
@@ -57,6 +112,12 @@ public:
                             const std::string &propName, PropertyGetter getter,
                             PropertySetter setter = nullptr);
 
+    // Add a property that reads and writes a data member directly, e.g.
+    // AddField<&BasePart::Position>("Position"). The class is the member's
+    // owner; the member type must have a LuaField specialization.
+    template <auto Member>
+    static void AddField(const std::string &propName, bool readonly = false);
+
     // Add method to a class
     static void AddMethod(const std::string &className,
                           const std::string &methodName, MethodFunc method);
@@ -65,6 +126,9 @@ public:
     static void SetConstructor(const std::string &className,
                                std::function<Instance *()> ctor);
 
+    // Add a function to the global Instance table (Instance.<name>)
+    static void AddStaticFunction(const std::string &name, lua_CFunction fn);
+
     // Bind all registered classes to Lua
     static void BindAll(lua_State *L);
 
@@ -72,12 +136,51 @@ public:
     static bool IsA(lua_State *L, int idx, const std::string &className);
 
     // Get instance from userdata (with type checking)
+    static Instance *CheckInstance(lua_State *L, int idx);
     static Instance *CheckInstance(lua_State *L, int idx,
-                                   const std::string &className = "Instance");
+                                   const std::string &className);
+    static Instance *CheckInstance(lua_State *L, int idx, ClassId classId);
+
+    // Read an array of instances from the table at idx
+    static std::vector<Instance *> CheckInstanceList(lua_State *L, int idx);
 
-    // Push instance to Lua stack
+    // Push instance to Lua stack. Reuses the instance's existing userdata
+    // while Lua still references it.
     static void PushInstance(lua_State *L, Instance *inst);
 
+    // Member lookup by Luau string address (see DispatchTable)
+    static const DispatchEntry *FindMember(ClassId classId, const char *key);
+
     // Get class descriptor (now public for external access)
     static ClassDescriptor *GetDescriptor(const std::string &className);
-};
\ No newline at end of file
+};
+
+template <auto Member>
+void LuaClassBinder::AddField(const std::string &propName, bool readonly) {
+    using Class = typename FieldMember<Member>::Class;
+    using T = typename FieldMember<Member>::Type;
+
+    PropertyDescriptor prop;
+    prop.getter = [](lua_State *L, Instance *inst) -> int {
+        LuaField<T>::Push(L, static_cast<Class *>(inst)->*Member);
+        return 1;
+    };
+    if (!readonly) {
+        prop.setter = [](lua_State *L, Instance *inst, int valueIdx) -> int {
+            static_cast<Class *>(inst)->*Member =
+                LuaField<T>::Check(L, valueIdx);
+            return 0;
+        };
+    }
+    prop.readonly = readonly;
+    prop.fieldType = LuaField<T>::Type;
+
+    prop.fieldOffset = [](const Instance *inst) -> size_t {
+        const auto *object = static_cast<const Class *>(inst);
+        return (size_t)(reinterpret_cast<const unsigned char *>(
+                            &(object->*Member)) -
+                        reinterpret_cast<const unsigned char *>(inst));
+    };
+
+    AddPropertyDescriptor(Class::StaticClassName, propName, prop);
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../../luau/VM/include/lua.h"
+#include "../../luau/VM/include/lualib.h"
+#include "../datatypes/Color3.h"
+#include "../datatypes/Vector3.h"
+
+// C++ type of a property bound directly to a data member (see
+// LuaClassBinder::AddField). None for properties with hand-written accessors.
+enum class FieldType : uint8_t {
+    None,
+    Bool,
+    Float,
+    Double,
+    String,
+    Vector3,
+    Color3,
+};
+
+// Bytes the member occupies; 0 for None
+inline size_t FieldTypeSize(FieldType type) {
+    switch (type) {
+    case FieldType::Bool:
+        return sizeof(bool);
+    case FieldType::Float:
+        return sizeof(float);
+    case FieldType::Double:
+        return sizeof(double);
+    case FieldType::String:
+        return sizeof(std::string);
+    case FieldType::Vector3:
+        return sizeof(Vector3Game);
+    case FieldType::Color3:
+        return sizeof(Color3);
+    default:
+        return 0;
+    }
+}
+
+// Whether the member can be copied and compared bytewise
+inline bool FieldTypeIsTrivial(FieldType type) {
+    return type != FieldType::None && type != FieldType::String;
+}
+
+// Name of the member's C++ type, as reported to Lua
+inline const char *FieldTypeName(FieldType type) {
+    switch (type) {
+    case FieldType::Bool:
+        return "bool";
+    case FieldType::Float:
+        return "float";
+    case FieldType::Double:
+        return "double";
+    case FieldType::String:
+        return "string";
+    case FieldType::Vector3:
+        return "Vector3";
+    case FieldType::Color3:
+        return "Color3";
+    default:
+        return nullptr;
+    }
+}
+
+// Lua conversion for each member type AddField accepts
+template <typename T> struct LuaField;
+
+template <> struct LuaField<bool> {
+    static constexpr FieldType Type = FieldType::Bool;
+    static void Push(lua_State *L, bool value) { lua_pushboolean(L, value); }
+    static bool Check(lua_State *L, int idx) {
+        return lua_toboolean(L, idx) != 0;
+    }
+};
+
+template <> struct LuaField<float> {
+    static constexpr FieldType Type = FieldType::Float;
+    static void Push(lua_State *L, float value) { lua_pushnumber(L, value); }
+    static float Check(lua_State *L, int idx) {
+        return (float)luaL_checknumber(L, idx);
+    }
+};
+
+template <> struct LuaField<double> {
+    static constexpr FieldType Type = FieldType::Double;
+    static void Push(lua_State *L, double value) { lua_pushnumber(L, value); }
+    static double Check(lua_State *L, int idx) {
+        return luaL_checknumber(L, idx);
+    }
+};
+
+template <> struct LuaField<std::string> {
+    static constexpr FieldType Type = FieldType::String;
+    static void Push(lua_State *L, const std::string &value) {
+        lua_pushlstring(L, value.data(), value.size());
+    }
+    static std::string Check(lua_State *L, int idx) {
+        size_t len = 0;
+        const char *s = luaL_checklstring(L, idx, &len);
+        return std::string(s, len);
+    }
+};
+
+template <> struct LuaField<Vector3Game> {
+    static constexpr FieldType Type = FieldType::Vector3;
+    static void Push(lua_State *L, const Vector3Game &value) {
+        Vector3Game_Push(L, value);
+    }
+    static Vector3Game Check(lua_State *L, int idx) {
+        return Vector3Game_Check(L, idx);
+    }
+};
+
+template <> struct LuaField<Color3> {
+    static constexpr FieldType Type = FieldType::Color3;
+    static void Push(lua_State *L, const Color3 &value) {
+        Color3_Push(L, value);
+    }
+    static Color3 Check(lua_State *L, int idx) { return Color3_Check(L, idx); }
+};
+
+// Splits a pointer to data member into its class and member type
+template <auto Member> struct FieldMember;
+
+template <typename C, typename T, T C::*Member> struct FieldMember<Member> {
+    using Class = C;
+    using Type = T;
+};
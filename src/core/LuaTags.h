@@ -0,0 +1,17 @@
+#pragma once
+
+// Luau userdata tags for engine datatypes. Each tag's metatable is attached
+// with lua_setuserdatametatable, so creating a value needs no registry lookup
+// and a type check is a tag compare (lua_touserdatatagged). Tag 0 is plain
+// untagged userdata.
+enum LuaUserdataTag : int {
+    kEnumItemTag = 1,
+    // InstanceHandle; each class keeps its own metatable, set per userdata
+    kInstanceTag = 2,
+};
+
+// Luau light userdata tags for datatypes packed into the pointer value (see
+// Color3_Push). Tag 0 is plain light userdata.
+enum LuaLightUserdataTag : int {
+    kColor3Tag = 1,
+};
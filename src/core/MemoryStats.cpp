@@ -0,0 +1,35 @@
+#include "MemoryStats.h"
+
+// Kept in its own translation unit: windows.h clashes with raylib.h
+#if defined(_WIN32)
+#include <windows.h>
+
+#include <psapi.h>
+
+size_t GetResidentMemoryBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                              sizeof(counters)))
+        return 0;
+    return counters.WorkingSetSize;
+}
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+
+size_t GetResidentMemoryBytes() {
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (!file)
+        return 0;
+
+    unsigned long size = 0, resident = 0;
+    int read = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    if (read != 2)
+        return 0;
+
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+#else
+size_t GetResidentMemoryBytes() { return 0; }
+#endif
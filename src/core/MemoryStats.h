@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+// Resident set size of this process in bytes, or 0 if the platform does not
+// expose it. Used by benchmarks to measure per-instance memory cost.
+size_t GetResidentMemoryBytes();
@@ -0,0 +1,48 @@
+#include "ObjectPool.h"
+#include <algorithm>
+
+static size_t RoundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+ObjectPool::ObjectPool(size_t slotSize, size_t alignment, size_t slotsPerChunk)
+    : alignment(std::max(alignment, alignof(FreeSlot))),
+      slotsPerChunk(slotsPerChunk) {
+    // Every slot must hold a free list link and keep the next slot aligned
+    this->slotSize =
+        RoundUp(std::max(slotSize, sizeof(FreeSlot)), this->alignment);
+}
+
+ObjectPool::~ObjectPool() {
+    for (unsigned char *chunk : chunks)
+        ::operator delete(chunk, std::align_val_t(alignment));
+}
+
+void *ObjectPool::Allocate() {
+    ++liveCount;
+
+    if (freeList) {
+        FreeSlot *slot = freeList;
+        freeList = slot->next;
+        return slot;
+    }
+
+    if (chunkRemaining == 0) {
+        chunkCursor = static_cast<unsigned char *>(::operator new(
+            slotSize * slotsPerChunk, std::align_val_t(alignment)));
+        chunks.push_back(chunkCursor);
+        chunkRemaining = slotsPerChunk;
+    }
+
+    void *slot = chunkCursor;
+    chunkCursor += slotSize;
+    --chunkRemaining;
+    return slot;
+}
+
+void ObjectPool::Free(void *ptr) {
+    FreeSlot *slot = static_cast<FreeSlot *>(ptr);
+    slot->next = freeList;
+    freeList = slot;
+    --liveCount;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "Config.h"
+
+// Fixed-size slab allocator. Slots are carved out of large chunks and freed
+// slots are recycled through an intrusive free list, so spawning and
+// destroying objects of one class never reaches malloc once warmed up.
+// Chunks are never returned to the system.
+class ObjectPool {
+private:
+    struct FreeSlot {
+        FreeSlot *next;
+    };
+
+    size_t slotSize;
+    size_t alignment;
+    size_t slotsPerChunk;
+
+    std::vector<unsigned char *> chunks;
+    FreeSlot *freeList = nullptr;
+
+    // Slots of the newest chunk not yet handed out
+    unsigned char *chunkCursor = nullptr;
+    size_t chunkRemaining = 0;
+
+    size_t liveCount = 0;
+
+public:
+    ObjectPool(size_t slotSize, size_t alignment, size_t slotsPerChunk = 256);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    void *Allocate();
+    void Free(void *ptr);
+
+    size_t GetLiveCount() const { return liveCount; }
+    size_t GetCapacity() const { return chunks.size() * slotsPerChunk; }
+};
+
+// Routes allocation of T through a pool dedicated to T. Inherit alongside the
+// engine base class (struct Part : public BasePart, public Pooled<Part>).
+// Subclasses of T that are larger fall back to the global allocator.
+// Built with LEMON_POOLED_ALLOCATION=0, T uses plain new/delete: the baseline
+// for the allocation benchmarks.
+template <typename T> struct Pooled {
+    static ObjectPool &Pool() {
+        // Intentionally leaked so deletes during static teardown stay valid
+        static ObjectPool *pool = new ObjectPool(sizeof(T), alignof(T));
+        return *pool;
+    }
+
+    static void *operator new(size_t size) {
+        if (!LEMON_POOLED_ALLOCATION || size != sizeof(T))
+            return ::operator new(size);
+        return Pool().Allocate();
+    }
+
+    static void operator delete(void *ptr, size_t size) {
+        if (!ptr)
+            return;
+        if (!LEMON_POOLED_ALLOCATION || size != sizeof(T))
+            ::operator delete(ptr);
+        else
+            Pool().Free(ptr);
+    }
+};
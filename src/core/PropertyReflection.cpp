@@ -0,0 +1,237 @@
+#include "PropertyReflection.h"
+#include "../instances/Instance.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+std::vector<PropertyReflection::ClassInfo> PropertyReflection::s_classes;
+
+static const unsigned char *FieldAddress(const PropertyInfo &info,
+                                         const Instance *inst) {
+    return reinterpret_cast<const unsigned char *>(inst) + info.OffsetOf(inst);
+}
+
+// Address of the value a FieldValue holds, laid out like the member
+static const void *ValueAddress(const FieldValue &value) {
+    return std::visit(
+        [](const auto &v) -> const void * {
+            if constexpr (std::is_same_v<std::decay_t<decltype(v)>,
+                                         std::monostate>)
+                return nullptr;
+            else
+                return &v;
+        },
+        value);
+}
+
+static bool FieldBytesEqual(const PropertyInfo &info, const void *a,
+                            const void *b) {
+    if (info.Type == FieldType::String)
+        return *static_cast<const std::string *>(a) ==
+               *static_cast<const std::string *>(b);
+    return memcmp(a, b, info.Size) == 0;
+}
+
+void PropertyReflection::Build(
+    const std::unordered_map<std::string, ClassDescriptor> &classes) {
+    auto parentOf =
+        [&](const ClassDescriptor *desc) -> const ClassDescriptor * {
+        if (desc->parentClassName.empty())
+            return nullptr;
+        auto it = classes.find(desc->parentClassName);
+        return it != classes.end() ? &it->second : nullptr;
+    };
+
+    s_classes.clear();
+    for (const auto &[className, desc] : classes) {
+        if (desc.classId == kInvalidClassId)
+            continue;
+
+        // Walk from the class up, so the nearest binding wins, as it does
+        // for the dispatch tables
+        std::unordered_map<std::string, PropertyInfo> found;
+        for (const ClassDescriptor *level = &desc; level;
+             level = parentOf(level)) {
+            for (const auto &[name, prop] : level->properties) {
+                if (found.count(name))
+                    continue;
+
+                PropertyInfo info;
+                info.Name = name;
+                info.Owner = level->classId;
+                info.Getter = prop.getter;
+                info.Setter = prop.setter;
+                info.ReadOnly = prop.readonly || !prop.setter;
+                info.Type = prop.fieldType;
+                info.OffsetOf = prop.fieldOffset;
+                info.Size = FieldTypeSize(prop.fieldType);
+                found.emplace(name, std::move(info));
+            }
+        }
+
+        ClassInfo classInfo;
+        classInfo.Properties.reserve(found.size());
+        for (auto &[name, info] : found)
+            classInfo.Properties.push_back(std::move(info));
+        std::sort(classInfo.Properties.begin(), classInfo.Properties.end(),
+                  [](const PropertyInfo &a, const PropertyInfo &b) {
+                      return a.Name < b.Name;
+                  });
+        for (size_t i = 0; i < classInfo.Properties.size(); ++i)
+            classInfo.ByName.emplace(classInfo.Properties[i].Name, i);
+
+        // Defaults come from a throwaway instance, so they include whatever
+        // the constructor sets
+        if (desc.constructor) {
+            Instance *prototype = desc.constructor();
+            for (PropertyInfo &info : classInfo.Properties)
+                info.Default = ReadField(info, prototype);
+            MeasureLayout(classInfo, prototype);
+            delete prototype;
+        }
+
+        if (s_classes.size() <= desc.classId)
+            s_classes.resize(desc.classId + 1);
+        s_classes[desc.classId] = std::move(classInfo);
+    }
+}
+
+void PropertyReflection::MeasureLayout(ClassInfo &classInfo,
+                                       const Instance *inst) {
+    // Every instance of a class shares its layout, so any one will do
+    std::vector<std::pair<size_t, size_t>> trivial;
+    for (const PropertyInfo &info : classInfo.Properties) {
+        if (info.ReadOnly || info.Type == FieldType::None)
+            continue;
+        size_t offset = info.OffsetOf(inst);
+        if (info.Type == FieldType::String)
+            classInfo.StringOffsets.push_back(offset);
+        else if (FieldTypeIsTrivial(info.Type))
+            trivial.emplace_back(offset, info.Size);
+    }
+    std::sort(trivial.begin(), trivial.end());
+    for (const auto &[offset, size] : trivial) {
+        auto &runs = classInfo.Runs;
+        if (!runs.empty() && runs.back().Offset + runs.back().Size >= offset) {
+            size_t end = std::max(runs.back().Offset + runs.back().Size,
+                                  offset + size);
+            runs.back().Size = end - runs.back().Offset;
+        } else {
+            runs.push_back({offset, size});
+        }
+    }
+    classInfo.LayoutKnown = true;
+}
+
+const PropertyReflection::ClassInfo *
+PropertyReflection::Layout(const Instance *inst) {
+    if (inst->ClassIndex >= s_classes.size())
+        return nullptr;
+
+    ClassInfo &classInfo = s_classes[inst->ClassIndex];
+    if (!classInfo.LayoutKnown)
+        MeasureLayout(classInfo, inst);
+    return &classInfo;
+}
+
+const std::vector<PropertyInfo> &
+PropertyReflection::GetProperties(ClassId classId) {
+    static const std::vector<PropertyInfo> none;
+    if (classId >= s_classes.size())
+        return none;
+    return s_classes[classId].Properties;
+}
+
+const PropertyInfo *PropertyReflection::FindProperty(ClassId classId,
+                                                     const std::string &name) {
+    if (classId >= s_classes.size())
+        return nullptr;
+    const ClassInfo &classInfo = s_classes[classId];
+    auto it = classInfo.ByName.find(name);
+    return it != classInfo.ByName.end() ? &classInfo.Properties[it->second]
+                                        : nullptr;
+}
+
+bool PropertyReflection::CopyFields(const Instance *src, Instance *dst) {
+    const ClassInfo *classInfo = Layout(src);
+    if (!classInfo || src->ClassIndex != dst->ClassIndex)
+        return false;
+
+    auto *from = reinterpret_cast<const unsigned char *>(src);
+    auto *to = reinterpret_cast<unsigned char *>(dst);
+    for (const FieldRun &run : classInfo->Runs)
+        memcpy(to + run.Offset, from + run.Offset, run.Size);
+    for (size_t offset : classInfo->StringOffsets)
+        *reinterpret_cast<std::string *>(to + offset) =
+            *reinterpret_cast<const std::string *>(from + offset);
+    return true;
+}
+
+bool PropertyReflection::FieldsEqual(const Instance *a, const Instance *b) {
+    const ClassInfo *classInfo = Layout(a);
+    if (!classInfo || a->ClassIndex != b->ClassIndex)
+        return false;
+
+    auto *lhs = reinterpret_cast<const unsigned char *>(a);
+    auto *rhs = reinterpret_cast<const unsigned char *>(b);
+    for (const FieldRun &run : classInfo->Runs)
+        if (memcmp(lhs + run.Offset, rhs + run.Offset, run.Size) != 0)
+            return false;
+    for (size_t offset : classInfo->StringOffsets)
+        if (*reinterpret_cast<const std::string *>(lhs + offset) !=
+            *reinterpret_cast<const std::string *>(rhs + offset))
+            return false;
+    return true;
+}
+
+bool PropertyReflection::FieldEquals(const PropertyInfo &info,
+                                     const Instance *a, const Instance *b) {
+    if (info.Type == FieldType::None)
+        return false;
+    return FieldBytesEqual(info, FieldAddress(info, a), FieldAddress(info, b));
+}
+
+bool PropertyReflection::IsDefault(const PropertyInfo &info,
+                                   const Instance *inst) {
+    const void *defaultValue = ValueAddress(info.Default);
+    if (!defaultValue)
+        return false;
+    return FieldBytesEqual(info, FieldAddress(info, inst), defaultValue);
+}
+
+FieldValue PropertyReflection::ReadField(const PropertyInfo &info,
+                                         const Instance *inst) {
+    if (info.Type == FieldType::None)
+        return std::monostate();
+
+    const unsigned char *field = FieldAddress(info, inst);
+    switch (info.Type) {
+    case FieldType::Bool:
+        return *reinterpret_cast<const bool *>(field);
+    case FieldType::Float:
+        return *reinterpret_cast<const float *>(field);
+    case FieldType::Double:
+        return *reinterpret_cast<const double *>(field);
+    case FieldType::String:
+        return *reinterpret_cast<const std::string *>(field);
+    case FieldType::Vector3:
+        return *reinterpret_cast<const Vector3Game *>(field);
+    case FieldType::Color3:
+        return *reinterpret_cast<const Color3 *>(field);
+    default:
+        return std::monostate();
+    }
+}
+
+void PropertyReflection::PushValue(lua_State *L, const FieldValue &value) {
+    std::visit(
+        [L](const auto &v) {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+                lua_pushnil(L);
+            else
+                LuaField<T>::Push(L, v);
+        },
+        value);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "ClassRegistry.h"
+#include "LuaClassBinder.h"
+#include "LuaField.h"
+
+struct Instance;
+
+// Value of a field property, one alternative per FieldType
+using FieldValue = std::variant<std::monostate, bool, float, double,
+                                std::string, Vector3Game, Color3>;
+
+// One bound property as seen from a class, after inheritance is resolved
+struct PropertyInfo {
+    std::string Name;
+    // Class that binds the property
+    ClassId Owner = kInvalidClassId;
+    // Accessors, as called from Lua
+    PropertyGetter Getter = nullptr;
+    PropertySetter Setter = nullptr;
+    bool ReadOnly = false;
+    // Set for properties bound with AddField: the member's type, offset from
+    // the start of a given instance of the class, and size. None for
+    // hand-written accessors.
+    FieldType Type = FieldType::None;
+    size_t (*OffsetOf)(const Instance *inst) = nullptr;
+    size_t Size = 0;
+    // Field value in a newly created instance of the class; monostate when
+    // the class cannot be created or the property is not a field
+    FieldValue Default;
+};
+
+// Reflection data for every bound class, built from the LuaClassBinder
+// descriptors by BindAll. Lets serialization, cloning, replication and the
+// editor enumerate, copy and compare properties without going through Lua.
+class PropertyReflection {
+private:
+    // Contiguous bytes covered by writable trivial fields, merged across
+    // neighbouring members
+    struct FieldRun {
+        size_t Offset = 0;
+        size_t Size = 0;
+    };
+
+    struct ClassInfo {
+        // Sorted by name
+        std::vector<PropertyInfo> Properties;
+        std::unordered_map<std::string, size_t> ByName;
+        // Measured on the prototype at Build time, or for classes without
+        // one (services) on the first instance copied or compared
+        bool LayoutKnown = false;
+        std::vector<FieldRun> Runs;
+        std::vector<size_t> StringOffsets;
+    };
+
+    // Indexed by ClassId; empty for classes never bound
+    static std::vector<ClassInfo> s_classes;
+
+    static void MeasureLayout(ClassInfo &classInfo, const Instance *inst);
+    static const ClassInfo *Layout(const Instance *inst);
+
+public:
+    static void
+    Build(const std::unordered_map<std::string, ClassDescriptor> &classes);
+
+    // Properties of a class including inherited ones, sorted by name
+    static const std::vector<PropertyInfo> &GetProperties(ClassId classId);
+
+    static const PropertyInfo *FindProperty(ClassId classId,
+                                            const std::string &name);
+
+    // Copy every writable field property from src to dst, bytewise where the
+    // type allows. Both must be the same class; returns false otherwise.
+    static bool CopyFields(const Instance *src, Instance *dst);
+
+    // Whether every writable field property of a and b is equal. Trivial
+    // fields compare bytewise, so -0 differs from 0 and NaN equals itself.
+    static bool FieldsEqual(const Instance *a, const Instance *b);
+
+    // Per-property comparisons, for diffing; info must be a field
+    static bool FieldEquals(const PropertyInfo &info, const Instance *a,
+                            const Instance *b);
+    static bool IsDefault(const PropertyInfo &info, const Instance *inst);
+
+    static FieldValue ReadField(const PropertyInfo &info,
+                                const Instance *inst);
+
+    static void PushValue(lua_State *L, const FieldValue &value);
+};
@@ -29,7 +29,7 @@ Texture2D GenerateDefaultTexture(int width, int height) {
     return tex;
 }
 
-void DrawPart(const Part part) {
+void DrawPart(const Part &part) {
     rlPushMatrix();
 
     rlTranslatef(part.Position.x, part.Position.y, part.Position.z);
@@ -44,21 +44,18 @@ void DrawPart(const Part part) {
 
     Model *model = nullptr;
 
-    Vector3 pos = {0, 0, 0};
-    Vector3 size = {1, 1, 1};
-
     if (part.Shape == "Block") {
-        model = GetPrimitiveModel(PrimitiveShape::Block);
+        model = GetPrimitiveModel(PartType::Block);
     } else if (part.Shape == "Sphere") {
-        model = GetPrimitiveModel(PrimitiveShape::Sphere);
+        model = GetPrimitiveModel(PartType::Ball);
     } else if (part.Shape == "Cylinder") {
-        model = GetPrimitiveModel(PrimitiveShape::Cylinder);
+        model = GetPrimitiveModel(PartType::Cylinder);
     } else if (part.Shape == "Wedge") {
-        model = GetPrimitiveModel(PrimitiveShape::Wedge);
+        model = GetPrimitiveModel(PartType::Wedge);
     } else if (part.Shape == "CornerWedge") {
-        model = GetPrimitiveModel(PrimitiveShape::CornerWedge);
+        model = GetPrimitiveModel(PartType::CornerWedge);
     } else {
-        model = GetPrimitiveModel(PrimitiveShape::Block);
+        model = GetPrimitiveModel(PartType::Block);
     }
 
     if (model) {
@@ -75,11 +72,8 @@ void RenderScene(Camera3D camera, const std::vector<BasePart *> instances) {
     DrawSkybox();
 
     for (BasePart *inst : instances) {
-        if (inst->ClassName == "Part") {
-            Part *p = dynamic_cast<Part *>(inst);
-            if (p)
-                DrawPart(*p);
-        }
+        if (Part *p = inst->As<Part>())
+            DrawPart(*p);
     }
 
     EndMode3D();
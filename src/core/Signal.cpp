@@ -1,4 +1,5 @@
 #include "Signal.h"
+#include "LuaClassBinder.h"
 
 void Signal::ConnectLua(lua_State *state, int funcIndex) {
     if (!state)
@@ -8,10 +9,27 @@ void Signal::ConnectLua(lua_State *state, int funcIndex) {
     lua_pushvalue(state, funcIndex);
     int ref = lua_ref(state, LUA_REGISTRYINDEX);
     LuaConnections.push_back(ref);
+    NotifyConnectionsChanged();
 }
 
 void Signal::Connect(const std::function<void(Instance *)> &cb) {
     CppConnections.push_back(cb);
+    NotifyConnectionsChanged();
+}
+
+void Signal::Fire() {
+    for (auto &cb : CppConnections)
+        cb(nullptr);
+
+    if (!L)
+        return;
+    for (size_t i = 0; i < LuaConnections.size(); ++i) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LuaConnections[i]);
+        if (lua_pcall(L, 0, 0, 0) != LUA_OK) {
+            printf("Signal Lua error: %s\n", lua_tostring(L, -1));
+            lua_pop(L, 1);
+        }
+    }
 }
 
 void Signal::Fire(const std::string &s) {
@@ -20,8 +38,9 @@ void Signal::Fire(const std::string &s) {
 
     if (!L)
         return;
-    for (int ref : LuaConnections) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+    // Index loop: a callback may connect or disconnect handlers
+    for (size_t i = 0; i < LuaConnections.size(); ++i) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LuaConnections[i]);
         lua_pushstring(L, s.c_str());
         if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
             printf("Signal Lua error: %s\n", lua_tostring(L, -1));
@@ -36,15 +55,10 @@ void Signal::Fire(Instance *inst) {
 
     if (!L)
         return;
-    for (int ref : LuaConnections) {
-        lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
-
-        // This is a bit of a hack, but it works for now
-        // We need to push the instance to the stack
-        Instance **udata = (Instance **)lua_newuserdata(L, sizeof(Instance *));
-        *udata = inst;
-        luaL_getmetatable(L, "Instance");
-        lua_setmetatable(L, -2);
+    // Index loop: a callback may connect more handlers while we fire
+    for (size_t i = 0; i < LuaConnections.size(); ++i) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, LuaConnections[i]);
+        LuaClassBinder::PushInstance(L, inst);
 
         if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
             printf("Signal Lua error: %s\n", lua_tostring(L, -1));
@@ -60,4 +74,5 @@ void Signal::DisconnectAll() {
 
     LuaConnections.clear();
     CppConnections.clear();
+    NotifyConnectionsChanged();
 }
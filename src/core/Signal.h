@@ -25,10 +25,23 @@ struct Connection {
 };
 
 struct Signal {
+    Signal() = default;
+
+    // Copies start with no connections and no owner hook, so cloned
+    // instances do not inherit their source's listeners
+    Signal(const Signal &) {}
+    Signal &operator=(const Signal &) { return *this; }
+
     lua_State *L = nullptr;
     std::vector<int> LuaConnections; // LUA registry refs
     std::vector<std::function<void(Instance *)>> CppConnections;
 
+    // Called with Owner after connections are added or removed, from Lua or
+    // C++, for owners that track whether anyone listens. Unset on most
+    // signals.
+    void (*OnConnectionsChanged)(Instance *owner) = nullptr;
+    Instance *Owner = nullptr;
+
     // Lua
     void ConnectLua(lua_State *L, int funcIndex);
 
@@ -36,8 +49,15 @@ struct Signal {
     void Connect(const std::function<void(Instance *)> &cb);
 
     // Fire
+    void Fire();
     void Fire(const std::string &s);
     void Fire(Instance *inst);
 
     void DisconnectAll();
+
+private:
+    void NotifyConnectionsChanged() {
+        if (OnConnectionsChanged)
+            OnConnectionsChanged(Owner);
+    }
 };
@@ -1,4 +1,6 @@
 #include "Color3.h"
+#include "../core/LuaAtoms.h"
+#include "../core/LuaTags.h"
 
 //--- Helper methods ---
 Color3 Color3::fromHSV(float h, float s, float v) {
@@ -31,16 +33,72 @@ Color3 Color3::Lerp(const Color3 &other, float alpha) const {
                   b + (other.b - b) * alpha);
 }
 
+// A Lua Color3 is a tagged light userdata whose pointer bits hold the
+// color: three 21-bit channels in 1/2^20 steps, plus a marker bit so black
+// is not a null pointer. Channels are clamped to [0, 1] by the constructor,
+// so 21 bits cover the whole range and dyadic values (0, 0.5, 1) are exact.
+static_assert(sizeof(void *) == sizeof(uint64_t),
+              "Color3 packing needs 64-bit pointers");
+
+static constexpr int kChannelBits = 21;
+static constexpr uint64_t kChannelMask = (1ull << kChannelBits) - 1;
+static constexpr float kChannelScale = (float)(1 << 20);
+static constexpr uint64_t kPackedMarker = 1ull << 63;
+
+static uint64_t PackChannel(float c) {
+    if (!(c > 0.0f)) // also catches NaN
+        return 0;
+    if (c >= 1.0f)
+        return 1 << 20;
+    return (uint64_t)lrintf(c * kChannelScale);
+}
+
+static float UnpackChannel(uint64_t packed, int channel) {
+    return (float)((packed >> (channel * kChannelBits)) & kChannelMask) /
+           kChannelScale;
+}
+
+void Color3_Push(lua_State *L, const Color3 &c) {
+    uint64_t packed = kPackedMarker | PackChannel(c.r) |
+                      PackChannel(c.g) << kChannelBits |
+                      PackChannel(c.b) << (2 * kChannelBits);
+    lua_pushlightuserdatatagged(L, (void *)(uintptr_t)packed, kColor3Tag);
+}
+
+bool Color3_Test(lua_State *L, int idx, Color3 &out) {
+    void *p = lua_tolightuserdatatagged(L, idx, kColor3Tag);
+    if (!p)
+        return false;
+    uint64_t packed = (uint64_t)(uintptr_t)p;
+    out.r = UnpackChannel(packed, 0);
+    out.g = UnpackChannel(packed, 1);
+    out.b = UnpackChannel(packed, 2);
+    return true;
+}
+
+Color3 Color3_Check(lua_State *L, int idx) {
+    Color3 c;
+    if (!Color3_Test(L, idx, c))
+        luaL_typeerror(L, idx, "Color3");
+    return c;
+}
+
+enum class Color3Member {
+    None,
+    R,
+    G,
+    B,
+    Lerp,
+};
+
+static AtomMap<Color3Member> s_members(Color3Member::None);
+
 static int Color3_new(lua_State *L) {
     float r = (float)luaL_checknumber(L, 1);
     float g = (float)luaL_checknumber(L, 2);
     float b = (float)luaL_checknumber(L, 3);
 
-    Color3 *c = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *c = Color3(r, g, b);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, Color3(r, g, b));
     return 1;
 }
 
@@ -49,11 +107,7 @@ static int Color3_fromRGB(lua_State *L) {
     int g = luaL_checkinteger(L, 2);
     int b = luaL_checkinteger(L, 3);
 
-    Color3 *c = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *c = Color3::fromRGB(r, g, b);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, Color3::fromRGB(r, g, b));
     return 1;
 }
 
@@ -62,90 +116,148 @@ static int Color3_fromHSV(lua_State *L) {
     float s = (float)luaL_checknumber(L, 2);
     float v = (float)luaL_checknumber(L, 3);
 
-    Color3 *c = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *c = Color3::fromHSV(h, s, v);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, Color3::fromHSV(h, s, v));
     return 1;
 }
 
 static int Color3_toRGB(lua_State *L) {
-    Color3 *c = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
+    Color3 c = Color3_Check(L, 1);
 
-    lua_pushinteger(L, (int)(c->r * 255.0f));
-    lua_pushinteger(L, (int)(c->g * 255.0f));
-    lua_pushinteger(L, (int)(c->b * 255.0f));
+    // Round, as the renderer does: channels are stored quantized, so a
+    // fromRGB byte can come back a hair below its exact value
+    lua_pushinteger(L, (int)lroundf(c.r * 255.0f));
+    lua_pushinteger(L, (int)lroundf(c.g * 255.0f));
+    lua_pushinteger(L, (int)lroundf(c.b * 255.0f));
     return 3;
 }
 
 static int Color3_lerp(lua_State *L) {
-    Color3 *a = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
-    Color3 *b = (Color3 *)luaL_checkudata(L, 2, "Color3Meta");
+    Color3 a = Color3_Check(L, 1);
+    Color3 b = Color3_Check(L, 2);
     float alpha = (float)luaL_checknumber(L, 3);
 
-    Color3 *result = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *result = a->Lerp(*b, alpha);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, a.Lerp(b, alpha));
     return 1;
 }
 
+// The metatable is shared by every light userdata, so each metamethod checks
+// the tag first and treats an untagged pointer (e.g. Workspace.CurrentCamera)
+// like userdata with no metatable
+static bool IsColor3(lua_State *L, int idx) {
+    return lua_type(L, idx) == LUA_TLIGHTUSERDATA &&
+           lua_lightuserdatatag(L, idx) == kColor3Tag;
+}
+
 static int Color3_tostring(lua_State *L) {
-    Color3 *c = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
-    lua_pushfstring(L, "Color3(%.3f, %.3f, %.3f)", c->r, c->g, c->b);
+    Color3 c;
+    if (!Color3_Test(L, 1, c)) {
+        lua_pushfstring(L, "userdata: %p", lua_tolightuserdata(L, 1));
+        return 1;
+    }
+    lua_pushfstring(L, "Color3(%.3f, %.3f, %.3f)", c.r, c.g, c.b);
     return 1;
 }
 
 static int Color3_add(lua_State *L) {
-    Color3 *a = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
-    Color3 *b = (Color3 *)luaL_checkudata(L, 2, "Color3Meta");
+    if (!IsColor3(L, 1) && !IsColor3(L, 2))
+        luaL_error(L, "attempt to perform arithmetic (add) on userdata");
+    Color3 a = Color3_Check(L, 1);
+    Color3 b = Color3_Check(L, 2);
 
-    Color3 *result = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *result = Color3(a->r + b->r, a->g + b->g, a->b + b->b);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, Color3(a.r + b.r, a.g + b.g, a.b + b.b));
     return 1;
 }
 
 static int Color3_mul(lua_State *L) {
-    Color3 *a = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
+    if (!IsColor3(L, 1) && !IsColor3(L, 2))
+        luaL_error(L, "attempt to perform arithmetic (mul) on userdata");
+    Color3 a = Color3_Check(L, 1);
     float s = (float)luaL_checknumber(L, 2);
 
-    Color3 *result = (Color3 *)lua_newuserdata(L, sizeof(Color3));
-    *result = Color3(a->r * s, a->g * s, a->b * s);
-
-    luaL_getmetatable(L, "Color3Meta");
-    lua_setmetatable(L, -2);
+    Color3_Push(L, Color3(a.r * s, a.g * s, a.b * s));
     return 1;
 }
 
-static int Color3_eq(lua_State *L) {
-    Color3 *a = (Color3 *)luaL_checkudata(L, 1, "Color3Meta");
-    Color3 *b = (Color3 *)luaL_checkudata(L, 2, "Color3Meta");
+static int Color3_index(lua_State *L) {
+    int atom = LuaAtoms::None;
+    const char *key = lua_tostringatom(L, 2, &atom);
+    if (!IsColor3(L, 1))
+        luaL_error(L, "attempt to index userdata with '%s'",
+                   key ? key : luaL_typename(L, 2));
+    Color3 c = Color3_Check(L, 1);
+    if (!key)
+        luaL_typeerror(L, 2, "string");
+
+    switch (s_members.Find(atom, key)) {
+    case Color3Member::R:
+        lua_pushnumber(L, c.r);
+        return 1;
+    case Color3Member::G:
+        lua_pushnumber(L, c.g);
+        return 1;
+    case Color3Member::B:
+        lua_pushnumber(L, c.b);
+        return 1;
+    case Color3Member::None:
+        break;
+    default:
+        lua_getmetatable(L, 1);
+        lua_rawgetfield(L, -1, key);
+        lua_remove(L, -2);
+        return 1;
+    }
 
-    lua_pushboolean(L, std::fabs(a->r - b->r) < 1e-6f &&
-                           std::fabs(a->g - b->g) < 1e-6f &&
-                           std::fabs(a->b - b->b) < 1e-6f);
-    return 1;
+    luaL_error(L, "Attempt to access invalid property '%s' of Color3", key);
+    return 0;
+}
+
+static int Color3_namecall(lua_State *L) {
+    int atom = LuaAtoms::None;
+    const char *name = lua_namecallatom(L, &atom);
+    if (!IsColor3(L, 1))
+        luaL_error(L, "attempt to index userdata with '%s'",
+                   name ? name : "?");
+
+    switch (s_members.Find(atom, name)) {
+    case Color3Member::Lerp:
+        return Color3_lerp(L);
+    default:
+        luaL_error(L, "%s is not a valid member of Color3", name ? name : "?");
+        return 0;
+    }
 }
 
 void Color3_Bind(lua_State *L) {
+    s_members.Add("R", Color3Member::R);
+    s_members.Add("G", Color3Member::G);
+    s_members.Add("B", Color3Member::B);
+    s_members.Add("Lerp", Color3Member::Lerp);
+
     // Metatable
-    luaL_newmetatable(L, "Color3Meta");
+    lua_newtable(L);
 
+    lua_pushcfunction(L, Color3_index, "__index");
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, Color3_namecall, "__namecall");
+    lua_setfield(L, -2, "__namecall");
     lua_pushcfunction(L, Color3_tostring, "__tostring");
     lua_setfield(L, -2, "__tostring");
     lua_pushcfunction(L, Color3_add, "__add");
     lua_setfield(L, -2, "__add");
     lua_pushcfunction(L, Color3_mul, "__mul");
     lua_setfield(L, -2, "__mul");
-    lua_pushcfunction(L, Color3_eq, "__eq");
-    lua_setfield(L, -2, "__eq");
+    // No __eq: light userdata compare by value, which for packed colors is
+    // exact channel equality
 
+    lua_pushcfunction(L, Color3_lerp, "Lerp");
+    lua_setfield(L, -2, "Lerp");
+
+    // Light userdata share one metatable per VM, set through any value
+    lua_pushlightuserdatatagged(L, nullptr, kColor3Tag);
+    lua_insert(L, -2);
+    lua_setmetatable(L, -2);
     lua_pop(L, 1);
+    lua_setlightuserdataname(L, kColor3Tag, "Color3");
 
     lua_newtable(L);
 
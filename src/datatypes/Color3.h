@@ -29,7 +29,7 @@
  */
 struct Color3 {
     /**
-     * @property r
+     * @property R
      * @type number
      * @description The red component of the color (0-1)
      * @readonly
@@ -37,7 +37,7 @@ struct Color3 {
     float r;
 
     /**
-     * @property g
+     * @property G
      * @type number
      * @description The green component of the color (0-1)
      * @readonly
@@ -45,7 +45,7 @@ struct Color3 {
     float g;
 
     /**
-     * @property b
+     * @property B
      * @type number
      * @description The blue component of the color (0-1)
      * @readonly
@@ -110,4 +110,12 @@ struct Color3 {
     Color3 Lerp(const Color3 &other, float alpha) const;
 };
 
-void Color3_Bind(lua_State *L);
\ No newline at end of file
+void Color3_Bind(lua_State *L);
+
+// Lua Color3 values are packed into tagged light userdata, so pushing one
+// never allocates. Channels round-trip with a precision of 2^-20.
+void Color3_Push(lua_State *L, const Color3 &c);
+// Fills out and returns true when idx holds a Color3
+bool Color3_Test(lua_State *L, int idx, Color3 &out);
+// The Color3 at idx; raises a Lua error for any other value
+Color3 Color3_Check(lua_State *L, int idx);
@@ -1,12 +1,41 @@
 #include "Task.h"
+#include "../instances/Instance.h"
+
+#include <cmath>
+#include <queue>
+#include <unordered_map>
 
 std::vector<LuaTask> g_tasks;
 
+// Parked tasks, keyed by park id. They are kept out of g_tasks so the
+// scheduler does not visit them every step, and Task_Wake finds them
+// without a scan.
+static std::unordered_map<uint64_t, LuaTask> s_parked;
+
+// Park timeouts, earliest first. Entries for tasks woken in the meantime
+// are skipped when they come up.
+using ParkTimeout = std::pair<double, uint64_t>;
+static std::priority_queue<ParkTimeout, std::vector<ParkTimeout>,
+                           std::greater<ParkTimeout>>
+    s_parkTimeouts;
+
+// Index in g_tasks of the task the scheduler is resuming, if any
+static size_t s_running = SIZE_MAX;
+
+// The scheduler task running on L, or nullptr when L is not one (the main
+// state, or a coroutine created inside a task)
+static LuaTask *RunningTask(lua_State *L) {
+    if (s_running < g_tasks.size() && g_tasks[s_running].thread == L)
+        return &g_tasks[s_running];
+    return nullptr;
+}
+
 int Task_RunScript(lua_State *L, std::string &scriptText) {
     size_t bcSize;
     lua_CompileOptions opts{};
     opts.optimizationLevel = 1;
     opts.debugLevel = 1;
+    Vector3Game_ConfigureCompiler(opts);
 
     const char *bytecode =
         luau_compile(scriptText.c_str(), scriptText.size(), &opts, &bcSize);
@@ -53,39 +82,117 @@ static int Task_Wait(lua_State *L) {
     double delay = luaL_optnumber(L, 1, 0.0);
     double now = GetTime();
 
-    for (auto &task : g_tasks) {
-        if (task.thread == L) {
-            task.SleepStartTime = now;
-            task.WakeTime = now + delay;
-            return lua_yield(L, 0);
-        }
+    LuaTask *task = RunningTask(L);
+    if (!task)
+        luaL_error(L, "attempted to use task.wait outside of a running task");
+
+    task->SleepStartTime = now;
+    task->WakeTime = now + delay;
+    return lua_yield(L, 0);
+}
+
+uint64_t Task_Park(lua_State *L, double timeout,
+                   std::function<void(uint64_t)> onTimeout) {
+    static uint64_t nextParkId = 0;
+
+    LuaTask *task = RunningTask(L);
+    if (!task)
+        return 0;
+
+    double now = GetTime();
+    task->Parked = true;
+    task->ParkId = ++nextParkId;
+    task->SleepStartTime = now;
+    task->WakeTime = timeout < 0 ? HUGE_VAL : now + timeout;
+    task->OnParkTimeout = std::move(onTimeout);
+    if (timeout >= 0)
+        s_parkTimeouts.push({task->WakeTime, task->ParkId});
+    // Moved to s_parked by the scheduler once the task yields
+    return task->ParkId;
+}
+
+// Take a task out of s_parked
+static LuaTask Unpark(std::unordered_map<uint64_t, LuaTask>::iterator it) {
+    LuaTask task = std::move(it->second);
+    s_parked.erase(it);
+    return task;
+}
+
+// Put an unparked task back in g_tasks, to resume on this or the next step
+// with the top nargs values on its stack
+static void Requeue(LuaTask &&task, int nargs) {
+    task.Parked = false;
+    task.OnParkTimeout = nullptr;
+    task.ResumeArgs = nargs;
+    task.WakeTime = 0.0;
+    g_tasks.push_back(std::move(task));
+}
+
+bool Task_Wake(lua_State *thread, uint64_t parkId, int nargs) {
+    auto it = s_parked.find(parkId);
+    if (it != s_parked.end() && it->second.thread == thread) {
+        Requeue(Unpark(it), nargs);
+        return true;
     }
 
-    luaL_error(L, "attempted to use task.wait outside of a running task");
-    return 0;
+    lua_pop(thread, nargs);
+    return false;
 }
 
 void TaskScheduler_Step() {
     double now = GetTime();
 
-    for (auto &task : g_tasks) {
+    // Parked tasks whose timeout passed resume with nil
+    while (!s_parkTimeouts.empty() && s_parkTimeouts.top().first <= now) {
+        uint64_t parkId = s_parkTimeouts.top().second;
+        s_parkTimeouts.pop();
+
+        auto it = s_parked.find(parkId);
+        if (it == s_parked.end())
+            continue;
+
+        LuaTask task = Unpark(it);
+        if (auto onTimeout = std::move(task.OnParkTimeout))
+            onTimeout(parkId);
+        lua_pushnil(task.thread);
+        Requeue(std::move(task), 1);
+    }
+
+    // Index loop: a resumed task may spawn more tasks and grow g_tasks
+    for (size_t i = 0; i < g_tasks.size(); ++i) {
+        LuaTask &task = g_tasks[i];
         if (task.Finished)
             continue;
 
         if (now >= task.WakeTime) {
-            double elapsed = now - task.SleepStartTime;
-            lua_pushnumber(task.thread, elapsed); // return value of task.wait()
+            int nargs = 1;
+            if (task.ResumeArgs >= 0) {
+                nargs = task.ResumeArgs;
+                task.ResumeArgs = -1;
+            } else {
+                double elapsed = now - task.SleepStartTime;
+                lua_pushnumber(task.thread, elapsed); // return value of task.wait()
+            }
 
-            int status = lua_resume(task.thread, nullptr, 1);
+            lua_State *thread = task.thread;
+            s_running = i;
+            int status = lua_resume(thread, nullptr, nargs);
+            s_running = SIZE_MAX;
 
             if (status == LUA_YIELD) {
-                // will be resumed later
+                // Parked tasks wait apart until woken or timed out; the
+                // emptied slot is erased with the finished ones
+                if (g_tasks[i].Parked) {
+                    uint64_t parkId = g_tasks[i].ParkId;
+                    s_parked.emplace(parkId, std::move(g_tasks[i]));
+                    g_tasks[i].Finished = true;
+                }
             } else if (status == LUA_OK) {
-                task.Finished = true;
+                g_tasks[i].Finished = true;
             } else {
-                printf("Lua error: %s\n", lua_tostring(task.thread, -1));
-                lua_pop(task.thread, 1);
-                task.Finished = true;
+                printf("Lua error: %s\n", lua_tostring(thread, -1));
+                lua_pop(thread, 1);
+                g_tasks[i].Finished = true;
             }
         }
     }
@@ -93,6 +200,10 @@ void TaskScheduler_Step() {
     g_tasks.erase(std::remove_if(g_tasks.begin(), g_tasks.end(),
                                  [](const LuaTask &t) { return t.Finished; }),
                   g_tasks.end());
+
+    // No script is running here, so nothing on a C++ stack can still point
+    // at an instance destroyed this step
+    Instance::FreeDestroyed();
 }
 
 // Run until no runnable tasks remain
@@ -102,7 +213,7 @@ bool TaskScheduler_RunToIdle() {
     size_t lastRemaining = SIZE_MAX;
     int stagnation = 0;
     for (;;) {
-        size_t remaining = 0;
+        size_t remaining = s_parked.size();
         for (const auto &t : g_tasks)
             if (!t.Finished)
                 ++remaining;
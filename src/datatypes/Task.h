@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <functional>
 #include <string>
@@ -38,6 +39,19 @@ struct LuaTask {
     double SleepStartTime = 0.0;
     bool Finished = false;
 
+    // Parked tasks wait for Task_Wake rather than a time; WakeTime is the
+    // timeout, or infinity
+    bool Parked = false;
+    uint64_t ParkId = 0;
+
+    // Values Task_Wake left on the thread's stack to resume with, or -1 to
+    // resume with the elapsed time
+    int ResumeArgs = -1;
+
+    // Called with ParkId if the park times out, so whoever registered the
+    // task can forget it
+    std::function<void(uint64_t)> OnParkTimeout;
+
     LuaTask(lua_State *L) : thread(lua_newthread(L)) {}
 };
 
@@ -49,6 +63,8 @@ struct SleepingTask {
     double wakeTime; // in seconds
 };
 
+// Runnable and sleeping tasks. Parked tasks are held apart until they are
+// woken or time out, so they cost nothing per step.
 extern std::vector<LuaTask> g_tasks;
 
 int Task_RunScript(lua_State *L, std::string &scriptText);
@@ -85,6 +101,27 @@ int Task_RunScript(lua_State *L, std::string &scriptText);
  * ```
  */
 
+/**
+ * @internal
+ * @description Marks the task running on L as parked and returns its park
+ * id, or 0 when L is not a scheduler task. The caller registers the id with
+ * whatever will wake it, then returns lua_yield(L, 0). Parked tasks are not
+ * resumed until Task_Wake, or until timeout seconds pass (negative waits
+ * forever), in which case onTimeout is called with the park id and the
+ * yielding call returns nil.
+ */
+uint64_t Task_Park(lua_State *L, double timeout,
+                   std::function<void(uint64_t)> onTimeout = nullptr);
+
+/**
+ * @internal
+ * @description Makes a parked task runnable on the next scheduler step. The
+ * top nargs values on thread's stack become the results of the yielding
+ * call. Returns false, and pops them, if the task is no longer parked under
+ * parkId (it timed out or finished).
+ */
+bool Task_Wake(lua_State *thread, uint64_t parkId, int nargs);
+
 void TaskScheduler_Step();
 bool TaskScheduler_RunToIdle();
 void Task_Bind(lua_State *L);
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Vector3.h"
+#include "../core/LuaAtoms.h"
 
 const Vector3Game Vector3_zero = Vector3Game{0, 0, 0};
 const Vector3Game Vector3_one = Vector3Game{1, 1, 1};
@@ -7,240 +8,214 @@ const Vector3Game Vector3_xAxis = Vector3Game{1, 0, 0};
 const Vector3Game Vector3_yAxis = Vector3Game{0, 1, 0};
 const Vector3Game Vector3_zAxis = Vector3Game{0, 0, 1};
 
-static int Vector3_new(lua_State *L) {
-    float x = (float)luaL_optnumber(L, 1, 0);
-    float y = (float)luaL_optnumber(L, 2, 0);
-    float z = (float)luaL_optnumber(L, 3, 0);
-
-    Vector3Game *v = (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *v = Vector3Game{x, y, z};
-
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-
-    return 1;
+void Vector3Game_Push(lua_State *L, const Vector3Game &v) {
+    lua_pushvector(L, v.x, v.y, v.z);
 }
 
-static int Vector3_tostring(lua_State *L) {
-    Vector3Game *v3 = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    lua_pushfstring(L, "%f, %f, %f", v3->x, v3->y, v3->z);
-    return 1;
+bool Vector3Game_Test(lua_State *L, int idx, Vector3Game &out) {
+    const float *v = lua_tovector(L, idx);
+    if (!v)
+        return false;
+    out = Vector3Game{v[0], v[1], v[2]};
+    return true;
 }
 
-static int Vector3_add(lua_State *L) {
-    Vector3Game *a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = Vector3Game{a->x + b->x, a->y + b->y, a->z + b->z};
-
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-    return 1;
+Vector3Game Vector3Game_Check(lua_State *L, int idx) {
+    Vector3Game v;
+    if (!Vector3Game_Test(L, idx, v))
+        luaL_typeerror(L, idx, "Vector3");
+    return v;
 }
 
-static int Vector3_sub(lua_State *L) {
-    Vector3Game *a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = Vector3Game{a->x - b->x, a->y - b->y, a->z - b->z};
-
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-    return 1;
-}
-
-static int Vector3_mul(lua_State *L) {
-    Vector3Game *v;
-    float s;
-
-    if (lua_isnumber(L, 1)) {
-        s = (float)luaL_checknumber(L, 1);
-        v = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
-    } else {
-        v = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-        s = (float)luaL_checknumber(L, 2);
-    }
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = Vector3Game{v->x * s, v->y * s, v->z * s};
-
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-    return 1;
-}
-
-static int Vector3_div(lua_State *L) {
-    Vector3Game *v = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    float s = (float)luaL_checknumber(L, 2);
-
-    if (s == 0.0f) {
-        luaL_error(L, "division by zero");
-        return 0;
-    }
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = Vector3Game{v->x / s, v->y / s, v->z / s};
-
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-    return 1;
+void Vector3Game_ConfigureCompiler(lua_CompileOptions &opts) {
+    opts.vectorLib = "Vector3";
+    opts.vectorCtor = "new";
+    opts.vectorType = "Vector3";
 }
 
-static int Vector3_unm(lua_State *L) {
-    Vector3Game *v = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
+enum class Vector3Member {
+    None,
+    X,
+    Y,
+    Z,
+    Magnitude,
+    Unit,
+    Abs,
+    Ceil,
+    Floor,
+    Dot,
+    Cross,
+    Lerp,
+    FuzzyEq,
+};
+
+static AtomMap<Vector3Member> s_members(Vector3Member::None);
 
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = Vector3Game{-v->x, -v->y, -v->z};
+static int Vector3_new(lua_State *L) {
+    float x = (float)luaL_optnumber(L, 1, 0);
+    float y = (float)luaL_optnumber(L, 2, 0);
+    float z = (float)luaL_optnumber(L, 3, 0);
 
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
+    Vector3Game_Push(L, Vector3Game{x, y, z});
     return 1;
 }
 
-static int Vector3_index(lua_State *L) {
-    Vector3Game *v3 = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    const char *key = luaL_checkstring(L, 2);
-
-    if (strcmp(key, "X") == 0) {
-        lua_pushnumber(L, v3->x);
-    } else if (strcmp(key, "Y") == 0) {
-        lua_pushnumber(L, v3->y);
-    } else if (strcmp(key, "Z") == 0) {
-        lua_pushnumber(L, v3->z);
-    } else if (strcmp(key, "Magnitude") == 0) {
-        lua_pushnumber(L, v3->magnitude());
-    } else if (strcmp(key, "Unit") == 0) {
-        Vector3Game *result =
-            (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-        *result = v3->unit();
-        luaL_getmetatable(L, "Vector3Meta");
-        lua_setmetatable(L, -2);
-    } else {
-        // Try to find method in the metatable
-        luaL_getmetatable(L, "Vector3Meta");
-        lua_getfield(L, -1, key);
-
-        if (!lua_isnil(L, -1)) {
-            lua_remove(L, -2); // remove metatable, keep the value
-            return 1;
-        }
-
-        lua_pop(L, 2); // pop nil and metatable
-        luaL_error(L, "Attempt to access invalid property '%s' of Vector3",
-                   key);
-        return 0;
-    }
-
+static int Vector3_tostring(lua_State *L) {
+    Vector3Game v3 = Vector3Game_Check(L, 1);
+    lua_pushfstring(L, "%f, %f, %f", v3.x, v3.y, v3.z);
     return 1;
 }
 
 static int Vector3_abs(lua_State *L) {
-    Vector3Game *v3 = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = v3->abs();
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
+    Vector3Game v3 = Vector3Game_Check(L, 1);
 
+    Vector3Game_Push(L, v3.abs());
     return 1;
 }
 
 static int Vector3_ceil(lua_State *L) {
-    Vector3Game *v3 = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = v3->ceil();
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
+    Vector3Game v3 = Vector3Game_Check(L, 1);
 
+    Vector3Game_Push(L, v3.ceil());
     return 1;
 }
 
 static int Vector3_floor(lua_State *L) {
-    Vector3Game *v3 = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = v3->floor();
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
+    Vector3Game v3 = Vector3Game_Check(L, 1);
 
+    Vector3Game_Push(L, v3.floor());
     return 1;
 }
 
 static int Vector3_dot(lua_State *L) {
-    Vector3Game *v3a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *v3b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
+    Vector3Game v3a = Vector3Game_Check(L, 1);
+    Vector3Game v3b = Vector3Game_Check(L, 2);
 
-    lua_pushnumber(L, v3a->dot(*v3b));
+    lua_pushnumber(L, v3a.dot(v3b));
     return 1;
 }
 
 static int Vector3_cross(lua_State *L) {
-    Vector3Game *v3a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *v3b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
-
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = v3a->cross(*v3b);
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
+    Vector3Game v3a = Vector3Game_Check(L, 1);
+    Vector3Game v3b = Vector3Game_Check(L, 2);
 
+    Vector3Game_Push(L, v3a.cross(v3b));
     return 1;
 }
 
 static int Vector3_lerp(lua_State *L) {
-    Vector3Game *v3a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *v3b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
+    Vector3Game v3a = Vector3Game_Check(L, 1);
+    Vector3Game v3b = Vector3Game_Check(L, 2);
     float alpha = (float)luaL_checknumber(L, 3);
 
-    Vector3Game *result =
-        (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-    *result = v3a->lerp(*v3b, alpha);
-    luaL_getmetatable(L, "Vector3Meta");
-    lua_setmetatable(L, -2);
-
+    Vector3Game_Push(L, v3a.lerp(v3b, alpha));
     return 1;
 }
 
 static int Vector3_fuzzyeq(lua_State *L) {
-    Vector3Game *v3a = (Vector3Game *)luaL_checkudata(L, 1, "Vector3Meta");
-    Vector3Game *v3b = (Vector3Game *)luaL_checkudata(L, 2, "Vector3Meta");
+    Vector3Game v3a = Vector3Game_Check(L, 1);
+    Vector3Game v3b = Vector3Game_Check(L, 2);
 
-    lua_pushboolean(L, v3a->fuzzyequal(*v3b));
+    lua_pushboolean(L, v3a.fuzzyequal(v3b));
     return 1;
 }
 
+static lua_CFunction Vector3_method(Vector3Member member) {
+    switch (member) {
+    case Vector3Member::Abs:
+        return Vector3_abs;
+    case Vector3Member::Ceil:
+        return Vector3_ceil;
+    case Vector3Member::Floor:
+        return Vector3_floor;
+    case Vector3Member::Dot:
+        return Vector3_dot;
+    case Vector3Member::Cross:
+        return Vector3_cross;
+    case Vector3Member::Lerp:
+        return Vector3_lerp;
+    case Vector3Member::FuzzyEq:
+        return Vector3_fuzzyeq;
+    default:
+        return nullptr;
+    }
+}
+
+static int Vector3_index(lua_State *L) {
+    // v.X, v.Y and v.Z with constant keys never get here: the VM reads
+    // vector components itself
+    Vector3Game v3 = Vector3Game_Check(L, 1);
+    int atom = LuaAtoms::None;
+    const char *key = lua_tostringatom(L, 2, &atom);
+    if (!key)
+        luaL_typeerror(L, 2, "string");
+
+    switch (s_members.Find(atom, key)) {
+    case Vector3Member::X:
+        lua_pushnumber(L, v3.x);
+        return 1;
+    case Vector3Member::Y:
+        lua_pushnumber(L, v3.y);
+        return 1;
+    case Vector3Member::Z:
+        lua_pushnumber(L, v3.z);
+        return 1;
+    case Vector3Member::Magnitude:
+        lua_pushnumber(L, v3.magnitude());
+        return 1;
+    case Vector3Member::Unit:
+        Vector3Game_Push(L, v3.unit());
+        return 1;
+    case Vector3Member::None:
+        break;
+    default:
+        // Methods live in the metatable, so v.Dot is the same function
+        // every time
+        lua_getmetatable(L, 1);
+        lua_rawgetfield(L, -1, key);
+        lua_remove(L, -2);
+        return 1;
+    }
+
+    luaL_error(L, "Attempt to access invalid property '%s' of Vector3", key);
+    return 0;
+}
+
+static int Vector3_namecall(lua_State *L) {
+    int atom = LuaAtoms::None;
+    const char *name = lua_namecallatom(L, &atom);
+
+    lua_CFunction method = Vector3_method(s_members.Find(atom, name));
+    if (!method)
+        luaL_error(L, "%s is not a valid member of Vector3",
+                   name ? name : "?");
+    return method(L);
+}
+
 void Vector3Game_Bind(lua_State *L) {
-    luaL_newmetatable(L, "Vector3Meta");
+    s_members.Add("X", Vector3Member::X);
+    s_members.Add("Y", Vector3Member::Y);
+    s_members.Add("Z", Vector3Member::Z);
+    s_members.Add("Magnitude", Vector3Member::Magnitude);
+    s_members.Add("Unit", Vector3Member::Unit);
+    s_members.Add("Abs", Vector3Member::Abs);
+    s_members.Add("Ceil", Vector3Member::Ceil);
+    s_members.Add("Floor", Vector3Member::Floor);
+    s_members.Add("Dot", Vector3Member::Dot);
+    s_members.Add("Cross", Vector3Member::Cross);
+    s_members.Add("Lerp", Vector3Member::Lerp);
+    s_members.Add("FuzzyEq", Vector3Member::FuzzyEq);
 
-    lua_pushvalue(L, -1);
-    lua_setfield(L, -2, "__index");
+    lua_newtable(L);
 
     lua_pushcfunction(L, Vector3_index, "__index");
     lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, Vector3_namecall, "__namecall");
+    lua_setfield(L, -2, "__namecall");
 
+    // Arithmetic and equality on vectors are built into the VM
     lua_pushcfunction(L, Vector3_tostring, "__tostring");
     lua_setfield(L, -2, "__tostring");
-    lua_pushcfunction(L, Vector3_add, "__add");
-    lua_setfield(L, -2, "__add");
-    lua_pushcfunction(L, Vector3_sub, "__sub");
-    lua_setfield(L, -2, "__sub");
-    lua_pushcfunction(L, Vector3_mul, "__mul");
-    lua_setfield(L, -2, "__mul");
-    lua_pushcfunction(L, Vector3_div, "__div");
-    lua_setfield(L, -2, "__div");
-    lua_pushcfunction(L, Vector3_unm, "__unm");
-    lua_setfield(L, -2, "__unm");
 
     lua_pushcfunction(L, Vector3_abs, "Abs");
     lua_setfield(L, -2, "Abs");
@@ -257,16 +232,16 @@ void Vector3Game_Bind(lua_State *L) {
     lua_pushcfunction(L, Vector3_fuzzyeq, "FuzzyEq");
     lua_setfield(L, -2, "FuzzyEq");
 
+    // Vectors share one metatable per VM, set through any vector value
+    lua_pushvector(L, 0, 0, 0);
+    lua_insert(L, -2);
+    lua_setmetatable(L, -2);
     lua_pop(L, 1);
 
     lua_newtable(L);
 
     auto pushVector3Const = [L](const char *name, const Vector3Game &v) {
-        Vector3Game *ptr =
-            (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-        *ptr = v;
-        luaL_getmetatable(L, "Vector3Meta");
-        lua_setmetatable(L, -2);
+        Vector3Game_Push(L, v);
         lua_setfield(L, -2, name);
     };
 
@@ -280,4 +255,4 @@ void Vector3Game_Bind(lua_State *L) {
     lua_setfield(L, -2, "new");
 
     lua_setglobal(L, "Vector3");
-}
\ No newline at end of file
+}
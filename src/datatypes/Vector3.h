@@ -14,7 +14,7 @@
  * @description Vector3 is a fundamental datatype for representing positions,
  * directions, and sizes in 3D space. It supports common vector operations
  * including arithmetic, magnitude calculation, normalization, and
- * interpolation.
+ * interpolation. Vector3 values are immutable and compare by value.
  * @example
  * ```lua
  * -- Create a new vector
@@ -221,4 +221,16 @@ struct Vector3Game {
     }
 };
 
-void Vector3Game_Bind(lua_State *L);
\ No newline at end of file
+void Vector3Game_Bind(lua_State *L);
+
+// Lua Vector3 values are Luau's native vector type: plain stack values, so
+// pushing one never allocates and arithmetic runs inside the VM.
+void Vector3Game_Push(lua_State *L, const Vector3Game &v);
+// Fills out and returns true when idx holds a Vector3
+bool Vector3Game_Test(lua_State *L, int idx, Vector3Game &out);
+// The Vector3 at idx; raises a Lua error for any other value
+Vector3Game Vector3Game_Check(lua_State *L, int idx);
+
+// Lets the compiler lower Vector3.new(x, y, z) to the VM's vector
+// constructor. Apply to every lua_CompileOptions used for game scripts.
+void Vector3Game_ConfigureCompiler(lua_CompileOptions &opts);
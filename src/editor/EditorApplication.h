@@ -18,10 +18,11 @@ private:
         return buffer.str();
     }
 
-    // Compile and run a Lua chunk from source in the current state.
-    // Lua signature: __RUN_CHUNK(source: string, chunkname: string?) -> (bool
-    // ok, string? err)
-    static int L_RunChunk(lua_State *L) {
+    // Compile a Lua chunk from source in the current state. The caller runs
+    // it, so it may yield (tests can wait on the scheduler).
+    // Lua signature: __LOAD_CHUNK(source: string, chunkname: string?) ->
+    // (function?, string? err)
+    static int L_LoadChunk(lua_State *L) {
         size_t len = 0;
         const char *src = luaL_checklstring(L, 1, &len);
         const char *name = luaL_optstring(L, 2, "ScriptChunk");
@@ -30,27 +31,18 @@ private:
         lua_CompileOptions opts{};
         opts.optimizationLevel = 1;
         opts.debugLevel = 1;
+        Vector3Game_ConfigureCompiler(opts);
         const char *bytecode = luau_compile(src, len, &opts, &bcSize);
 
         int loadStatus = luau_load(L, name, bytecode, bcSize, 0);
         if (loadStatus != LUA_OK) {
             const char *err = lua_tostring(L, -1);
-            lua_pushboolean(L, 0);
+            lua_pushnil(L);
             lua_pushstring(L, err ? err : "load error");
             return 2;
         }
 
-        int status = lua_pcall(L, 0, 0, 0);
-        if (status != LUA_OK) {
-            const char *err = lua_tostring(L, -1);
-            lua_pushboolean(L, 0);
-            lua_pushstring(L, err ? err : "runtime error");
-            return 2;
-        }
-
-        lua_pushboolean(L, 1);
-        lua_pushnil(L);
-        return 2;
+        return 1;
     }
 
     bool RunTests() {
@@ -121,20 +113,26 @@ protected:
         baseplate->Color = Color3(Color{92, 92, 92, 0});
         baseplate->Position = Vector3Game{0, -8, 0};
         baseplate->Size = Vector3Game{2048, 16, 2048};
-        baseplate->Name = "Baseplate";
+        baseplate->SetName("Baseplate");
         baseplate->SetParent(workspace);
-        g_instances.push_back(baseplate);
+        AddToRenderList(baseplate);
     }
 
     void PostLuaInitialize() {
         // Expose helper to Lua (called after L_main is initialized)
-        lua_pushcfunction(L_main, L_RunChunk, "__RUN_CHUNK");
-        lua_setglobal(L_main, "__RUN_CHUNK");
+        lua_pushcfunction(L_main, L_LoadChunk, "__LOAD_CHUNK");
+        lua_setglobal(L_main, "__LOAD_CHUNK");
 
         // Run script/tests if specified
         if (runTests) {
             bool result = RunTests();
             if (headless) {
+                // Everything must be freed once the game is torn down
+                size_t leaked = Shutdown();
+                if (leaked) {
+                    printf("Shutdown leaked %zu instances\n", leaked);
+                    result = false;
+                }
                 exit(result ? 0 : 1);
             }
         } else if (scriptPath) {
@@ -0,0 +1,10 @@
+#include "BulkMoveMode.h"
+#include "../core/EnumRegistry.h"
+
+// Register Enum.BulkMoveMode from the C++ enum names, starting at 0
+static void RegisterEnum_BulkMoveMode(lua_State *L) {
+    RegisterEnumByNames(L, "BulkMoveMode", kBulkMoveModeNames,
+                        kBulkMoveModeCount, 0);
+}
+
+static EnumRegistrar s_registrar_BulkMoveMode(RegisterEnum_BulkMoveMode);
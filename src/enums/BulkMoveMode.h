@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @brief Controls which events Workspace:BulkMoveTo fires
+ * @description SkipChangedEvents, the default, moves the parts silently,
+ * like assigning part.Position. FireChangedEvents also fires Changed for
+ * Position (and Rotation when rotations are given) on every moved part.
+ * @example
+ * ```lua
+ * workspace:BulkMoveTo(parts, positions, nil, Enum.BulkMoveMode.FireChangedEvents)
+ * ```
+ */
+enum class BulkMoveMode : int {
+    FireChangedEvents = 0,
+    SkipChangedEvents,
+};
+
+inline constexpr const char *kBulkMoveModeNames[] = {
+    "FireChangedEvents",
+    "SkipChangedEvents",
+};
+
+inline constexpr int kBulkMoveModeCount =
+    sizeof(kBulkMoveModeNames) / sizeof(kBulkMoveModeNames[0]);
@@ -1,5 +1,6 @@
 #pragma once
 #include <climits>
+#include <cstdint>
 #include <cstring>
 
 #include "../datatypes/Color3.h"
@@ -13,6 +14,22 @@
 #include "../../luau/VM/include/lua.h"
 #include "../../luau/VM/include/lualib.h"
 
+// Render list slot. Copies start outside the list, as a cloned part is not
+// drawn until it is added, so BasePart's copy constructor can stay defaulted.
+struct RenderListSlot {
+    size_t Value = SIZE_MAX;
+
+    RenderListSlot() = default;
+    RenderListSlot(const RenderListSlot &) {}
+    RenderListSlot &operator=(const RenderListSlot &) { return *this; }
+
+    RenderListSlot &operator=(size_t index) {
+        Value = index;
+        return *this;
+    }
+    operator size_t() const { return Value; }
+};
+
 /**
  * @class BasePart
  * @brief Base class for all physical parts in the game world
@@ -34,8 +51,19 @@
  * ```
  */
 struct BasePart : public Instance {
+    static constexpr const char *StaticClassName = "BasePart";
+
+    static constexpr size_t NotRendered = SIZE_MAX;
+
     //-- Properties --//
-    std::string Name = ClassName;
+
+    /**
+     * @property RenderListIndex
+     * @internal
+     * @type number
+     * @description Slot of this part in the render list, or NotRendered
+     */
+    RenderListSlot RenderListIndex;
 
     /**
      * @property Position
@@ -167,8 +195,15 @@ struct BasePart : public Instance {
 
     //-- Methods --//
 
-    virtual ~BasePart() = default;
+    BasePart(const std::string &className = "BasePart");
+    virtual ~BasePart();
+
+protected:
+    // Copies every property; the copy is not in the render list
+    BasePart(const BasePart &other) = default;
+    Instance *CloneInstance() const override;
 
+public:
     /**
      * @method GetMass
      * @returns number
@@ -181,8 +216,6 @@ struct BasePart : public Instance {
      * ```
      */
     double GetMass();
-
-    virtual bool IsA(const std::string &className) const;
 };
 
 // Binding
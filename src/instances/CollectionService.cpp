@@ -0,0 +1,163 @@
+#include "CollectionService.h"
+#include "../core/LuaBindings.h"
+#include "../core/LuaClassBinder.h"
+
+CollectionService::CollectionService() : Instance("CollectionService") {}
+
+std::unordered_map<InternedString, CollectionService::TagEntry,
+                   InternedString::Hash> &
+CollectionService::Index() {
+    static std::unordered_map<InternedString, TagEntry, InternedString::Hash>
+        index;
+    return index;
+}
+
+CollectionService::TagEntry &
+CollectionService::GetEntry(const InternedString &tag) {
+    return Index()[tag];
+}
+
+bool CollectionService::Insert(TagEntry &entry, Instance *inst) {
+    if (!entry.Slots.emplace(inst, entry.Instances.size()).second)
+        return false;
+    entry.Instances.push_back(inst);
+    return true;
+}
+
+bool CollectionService::Erase(TagEntry &entry, Instance *inst) {
+    auto it = entry.Slots.find(inst);
+    if (it == entry.Slots.end())
+        return false;
+
+    // Swap the last instance into the freed slot
+    size_t slot = it->second;
+    Instance *last = entry.Instances.back();
+    entry.Instances[slot] = last;
+    entry.Slots[last] = slot;
+    entry.Instances.pop_back();
+    entry.Slots.erase(inst);
+    return true;
+}
+
+const std::vector<Instance *> &
+CollectionService::GetTagged(const std::string &tag) {
+    static const std::vector<Instance *> empty;
+
+    // Never-interned tags have no entry; don't grow the table for lookups
+    InternedString key;
+    if (!InternedString::Find(tag, key))
+        return empty;
+
+    auto it = Index().find(key);
+    return it != Index().end() ? it->second.Instances : empty;
+}
+
+Signal *CollectionService::GetInstanceAddedSignal(const std::string &tag) {
+    return &GetEntry(tag).InstanceAdded;
+}
+
+Signal *CollectionService::GetInstanceRemovedSignal(const std::string &tag) {
+    return &GetEntry(tag).InstanceRemoved;
+}
+
+void CollectionService::OnTagAdded(Instance *inst, const InternedString &tag) {
+    if (!inst->IsInDataModel())
+        return;
+
+    TagEntry &entry = GetEntry(tag);
+    if (Insert(entry, inst))
+        entry.InstanceAdded.Fire(inst);
+}
+
+void CollectionService::OnTagRemoved(Instance *inst,
+                                     const InternedString &tag) {
+    auto it = Index().find(tag);
+    if (it != Index().end() && Erase(it->second, inst))
+        it->second.InstanceRemoved.Fire(inst);
+}
+
+void CollectionService::SyncSubtree(Instance *root) {
+    struct Change {
+        Signal *signal;
+        Instance *inst;
+    };
+
+    bool inGame = root->IsInDataModel();
+    std::vector<Change> changes;
+
+    // Update the index first; listeners may edit the tree, so fire after
+    std::vector<Instance *> stack{root};
+    while (!stack.empty()) {
+        Instance *inst = stack.back();
+        stack.pop_back();
+
+        for (const InternedString &tag : inst->Tags) {
+            TagEntry &entry = GetEntry(tag);
+            if (inGame && Insert(entry, inst))
+                changes.push_back({&entry.InstanceAdded, inst});
+            else if (!inGame && Erase(entry, inst))
+                changes.push_back({&entry.InstanceRemoved, inst});
+        }
+
+        for (Instance *child = inst->FirstChild; child;
+             child = child->NextSibling)
+            if (child->TaggedSubtreeCount)
+                stack.push_back(child);
+    }
+
+    for (const Change &change : changes)
+        change.signal->Fire(change.inst);
+}
+
+void CollectionService::Bind(lua_State *) {
+    LuaClassBinder::RegisterClass("CollectionService", "Instance");
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "GetTagged",
+        [](lua_State *L, Instance *) -> int {
+            const auto &tagged = GetTagged(luaL_checkstring(L, 2));
+            lua_createtable(L, (int)tagged.size(), 0);
+            for (size_t i = 0; i < tagged.size(); ++i) {
+                LuaClassBinder::PushInstance(L, tagged[i]);
+                lua_rawseti(L, -2, (int)i + 1);
+            }
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "GetInstanceAddedSignal",
+        [](lua_State *L, Instance *) -> int {
+            Lua_PushSignal(L, GetInstanceAddedSignal(luaL_checkstring(L, 2)));
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "GetInstanceRemovedSignal",
+        [](lua_State *L, Instance *) -> int {
+            Lua_PushSignal(L,
+                           GetInstanceRemovedSignal(luaL_checkstring(L, 2)));
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "AddTag", [](lua_State *L, Instance *) -> int {
+            Instance *target = LuaClassBinder::CheckInstance(L, 2);
+            target->AddTag(luaL_checkstring(L, 3));
+            return 0;
+        });
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "RemoveTag",
+        [](lua_State *L, Instance *) -> int {
+            Instance *target = LuaClassBinder::CheckInstance(L, 2);
+            target->RemoveTag(luaL_checkstring(L, 3));
+            return 0;
+        });
+
+    LuaClassBinder::AddMethod(
+        "CollectionService", "HasTag", [](lua_State *L, Instance *) -> int {
+            Instance *target = LuaClassBinder::CheckInstance(L, 2);
+            lua_pushboolean(L, target->HasTag(luaL_checkstring(L, 3)));
+            return 1;
+        });
+}
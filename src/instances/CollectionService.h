@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../core/InternedString.h"
+#include "../core/Signal.h"
+#include "Instance.h"
+#include <unordered_map>
+#include <vector>
+
+#include "../../luau/Compiler/include/luacode.h"
+#include "../../luau/VM/include/lua.h"
+#include "../../luau/VM/include/lualib.h"
+
+/**
+ * @class CollectionService
+ * @brief Service for finding instances by tag
+ *
+ * @description
+ * CollectionService keeps a global index from each tag to the tagged
+ * instances that are descendants of the DataModel, so GetTagged does not
+ * scan the tree. The index is kept in sync as tagged instances are tagged,
+ * untagged, reparented into or out of the game, and destroyed.
+ *
+ * @inherits Instance
+ *
+ * @example
+ * ```lua
+ * local CollectionService = game:GetService("CollectionService")
+ * for _, lava in CollectionService:GetTagged("Lava") do
+ *     lava.Color = Color3.new(1, 0, 0)
+ * end
+ * ```
+ */
+struct CollectionService : public Instance {
+    static constexpr const char *StaticClassName = "CollectionService";
+
+    CollectionService();
+    virtual ~CollectionService() = default;
+
+protected:
+    // Services are singletons and cannot be cloned
+    Instance *CloneInstance() const override { return nullptr; }
+    bool CanDestroy() const override { return false; }
+
+public:
+
+    /**
+     * @method GetTagged
+     * @param tag string
+     * @returns table
+     * @description Returns every instance in the game with the given tag
+     */
+    static const std::vector<Instance *> &GetTagged(const std::string &tag);
+
+    /**
+     * @method GetInstanceAddedSignal
+     * @param tag string
+     * @returns Signal
+     * @description Fires with an instance when it gains the tag while in the
+     * game, or when a tagged instance enters the game
+     */
+    static Signal *GetInstanceAddedSignal(const std::string &tag);
+
+    /**
+     * @method GetInstanceRemovedSignal
+     * @param tag string
+     * @returns Signal
+     * @description Fires with an instance when it loses the tag, or when a
+     * tagged instance leaves the game or is destroyed
+     */
+    static Signal *GetInstanceRemovedSignal(const std::string &tag);
+
+    /**
+     * @method SyncSubtree
+     * @param root Instance
+     * @internal
+     * @description Brings the index in line with the tagged instances under
+     * root after root moved. Only branches containing tags are visited.
+     */
+    static void SyncSubtree(Instance *root);
+
+    /**
+     * @method OnTagAdded
+     * @internal
+     * @description Called by Instance::AddTag
+     */
+    static void OnTagAdded(Instance *inst, const InternedString &tag);
+
+    /**
+     * @method OnTagRemoved
+     * @internal
+     * @description Called by Instance::RemoveTag
+     */
+    static void OnTagRemoved(Instance *inst, const InternedString &tag);
+
+    static void Bind(lua_State *L);
+
+private:
+    struct TagEntry {
+        std::vector<Instance *> Instances;
+        std::unordered_map<Instance *, size_t> Slots;
+        Signal InstanceAdded;
+        Signal InstanceRemoved;
+    };
+
+    // Entries are never erased so signal pointers handed out stay valid
+    static std::unordered_map<InternedString, TagEntry, InternedString::Hash> &
+    Index();
+
+    static TagEntry &GetEntry(const InternedString &tag);
+    static bool Insert(TagEntry &entry, Instance *inst);
+    static bool Erase(TagEntry &entry, Instance *inst);
+};
@@ -1,6 +1,7 @@
 #include "DataModel.h"
 #include "../core/LuaBindings.h"
 #include "../core/LuaClassBinder.h"
+#include "CollectionService.h"
 #include "Workspace.h"
 
 DataModel *DataModel::Instance = nullptr;
@@ -28,9 +29,12 @@ DataModel *DataModel::GetInstance() {
     ::Instance *service = nullptr;
 
     if (serviceName == "Workspace") {
-        service = new Workspace();
+        Workspace *workspace = new Workspace();
         // Cache commonly used services
-        WorkspaceService = dynamic_cast<Workspace *>(service);
+        WorkspaceService = workspace;
+        service = workspace;
+    } else if (serviceName == "CollectionService") {
+        service = new CollectionService();
     }
     // Add more services here as needed
     // else if (serviceName == "Players") {
@@ -47,10 +51,6 @@ void DataModel::InitializeServices() {
     WorkspaceService->SetParent(this);
 }
 
-bool DataModel::IsA(const std::string &className) const {
-    return className == "DataModel" || ServiceProvider::IsA(className);
-}
-
 void DataModel::Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("DataModel", "ServiceProvider");
 }
\ No newline at end of file
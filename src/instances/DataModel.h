@@ -28,6 +28,8 @@ struct Workspace;
  * ```
  */
 struct DataModel : public ServiceProvider {
+    static constexpr const char *StaticClassName = "DataModel";
+
     static DataModel *Instance;
 
     Workspace *WorkspaceService = nullptr;
@@ -40,7 +42,5 @@ struct DataModel : public ServiceProvider {
 
     void InitializeServices();
 
-    virtual bool IsA(const std::string &className) const override;
-
     static void Bind(lua_State *L);
 };
\ No newline at end of file
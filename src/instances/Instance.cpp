@@ -1,75 +1,452 @@
 #include "Instance.h"
 #include "../core/LuaBindings.h"
 #include "../core/LuaClassBinder.h"
+#include "../core/PropertyReflection.h"
+#include "CollectionService.h"
 #include "DataModel.h"
+#include "InstanceQuery.h"
 #include "Part.h"
 #include "Workspace.h"
+#include <unordered_set>
+
+// Bumped by every subtree change while any query cache exists; with no
+// caches around, changes skip the ancestor walk entirely
+static uint64_t s_modificationEpoch = 0;
+static size_t s_queryCacheCount = 0;
+
+// Destroyed instances waiting for the next FreeDestroyed. Leaked so it
+// outlives any instance freed during static destruction.
+static std::vector<Instance *> &FreeQueue() {
+    static auto *queue = new std::vector<Instance *>();
+    return *queue;
+}
 
 Instance::Instance(const std::string &className)
-    : Object(className), Name(className) {}
+    : Object(className), Handle(InstanceTable::Register(this)) {
+    HookDescendantSignals();
+}
+
+Instance::Instance(const Instance &other)
+    : Object(other), Attributes(other.Attributes), Tags(other.Tags),
+      TaggedSubtreeCount(other.Tags.empty() ? 0 : 1),
+      Archivable(other.Archivable), Handle(InstanceTable::Register(this)) {
+    HookDescendantSignals();
+}
+
+Instance *Instance::CloneInstance() const { return new Instance(*this); }
+
+Instance *Instance::Clone() const {
+    if (!Archivable)
+        return nullptr;
+
+    // Copied parts join the render list, as parts made by Instance.new do,
+    // whether or not they end up under Workspace
+    auto cloneOne = [](const Instance *source) {
+        Instance *clone = source->CloneInstance();
+        if (clone)
+            if (auto *part = clone->As<BasePart>())
+                AddToRenderList(part);
+        return clone;
+    };
+
+    Instance *root = cloneOne(this);
+    if (!root)
+        return nullptr;
+
+    // (source, cloned parent) pairs. Children are pushed last to first so
+    // they pop, and are appended, in child order.
+    std::vector<std::pair<const Instance *, Instance *>> pending;
+    pending.reserve(ChildCount);
+
+    auto pushChildren = [&pending](const Instance *source, Instance *clone) {
+        for (const Instance *child = source->LastChild; child;
+             child = child->PrevSibling)
+            if (child->Archivable)
+                pending.emplace_back(child, clone);
+    };
+
+    // The copy has no listeners yet, so link directly without events
+    pushChildren(this, root);
+    while (!pending.empty()) {
+        auto [source, parent] = pending.back();
+        pending.pop_back();
+
+        Instance *clone = cloneOne(source);
+        if (!clone)
+            continue;
+        parent->LinkChild(clone);
+        pushChildren(source, clone);
+    }
+
+    return root;
+}
+
+Instance::~Instance() {
+    // Normally reached through FreeDestroyed, with the subtree already torn
+    // down. Deleting a live instance directly destroys it first, even a
+    // service or the DataModel.
+    DestroyTree();
+
+    if (QueuedForFree) {
+        auto &queue = FreeQueue();
+        std::replace(queue.begin(), queue.end(), this, (Instance *)nullptr);
+    }
+
+    DropQueryCache();
+    InstanceTable::Unregister(Handle);
+}
+
+InstanceExtras &Instance::GetExtras() {
+    if (!Extras)
+        Extras = std::make_unique<InstanceExtras>();
+    return *Extras;
+}
+
+//------ Lifetime ------//
 
-Instance::~Instance() { Destroy(); }
+void Instance::QueueFree() {
+    if (QueuedForFree)
+        return;
+
+    QueuedForFree = true;
+    FreeQueue().push_back(this);
+}
+
+size_t Instance::FreeDestroyed() {
+    // Swap first: freeing may destroy instances parented to a destroyed one
+    // after the fact, and those wait for the next call
+    std::vector<Instance *> pending;
+    pending.swap(FreeQueue());
+
+    size_t freed = 0;
+    for (Instance *inst : pending) {
+        if (!inst)
+            continue;
+
+        inst->QueuedForFree = false;
+        delete inst;
+        ++freed;
+    }
+    return freed;
+}
+
+void Instance::DestroyAll() {
+    // Destroying handlers may create instances, so repeat until a pass finds
+    // nothing left standing
+    std::vector<InstanceHandle> roots;
+    do {
+        roots.clear();
+        InstanceTable::ForEachLive([&roots](Instance *inst) {
+            if (!inst->Destroyed && !inst->Parent)
+                roots.push_back(inst->Handle);
+        });
+        for (InstanceHandle handle : roots)
+            if (Instance *root = InstanceTable::Resolve(handle))
+                root->DestroyTree();
+    } while (!roots.empty());
+}
+
+size_t Instance::GetLiveCount() { return InstanceTable::GetLiveCount(); }
 
 //------ Attributes ------//
 
-void Instance::SetAttribute(std::string &attribute, Attribute value) {
+static bool AttributeValuesEqual(const AttributeValue &a,
+                                 const AttributeValue &b) {
+    if (a.index() != b.index())
+        return false;
+
+    if (auto *va = std::get_if<Vector3Game>(&a)) {
+        const auto &vb = std::get<Vector3Game>(b);
+        return va->x == vb.x && va->y == vb.y && va->z == vb.z;
+    }
+    if (auto *ca = std::get_if<Color3>(&a)) {
+        const auto &cb = std::get<Color3>(b);
+        return ca->r == cb.r && ca->g == cb.g && ca->b == cb.b;
+    }
+    if (auto *sa = std::get_if<std::string>(&a))
+        return *sa == std::get<std::string>(b);
+    if (auto *da = std::get_if<double>(&a))
+        return *da == std::get<double>(b);
+    return std::get<bool>(a) == std::get<bool>(b);
+}
+
+void Instance::SetAttribute(const std::string &attribute,
+                            AttributeValue value) {
+    InternedString key(attribute);
     for (auto &attr : Attributes) {
-        if (attr.Name == attribute) {
-            attr = value;
-            AttributeChanged.Fire(attribute);
+        if (attr.Name == key) {
+            if (AttributeValuesEqual(attr.Value, value))
+                return;
+            attr.Value = std::move(value);
+            MarkSubtreeModified();
+            FireAttributeChanged(key);
             return;
         }
     }
-    Attributes.push_back(value);
-    AttributeChanged.Fire(attribute);
+
+    Attributes.push_back({key, std::move(value)});
+    MarkSubtreeModified();
+    FireAttributeChanged(key);
 }
 
-std::optional<Attribute> Instance::GetAttribute(std::string &attribute) {
-    for (auto &attr : Attributes) {
-        if (attr.Name == attribute) {
-            return attr;
+void Instance::RemoveAttribute(const std::string &attribute) {
+    InternedString key;
+    if (!InternedString::Find(attribute, key))
+        return;
+
+    for (auto it = Attributes.begin(); it != Attributes.end(); ++it) {
+        if (it->Name == key) {
+            Attributes.erase(it);
+            MarkSubtreeModified();
+            FireAttributeChanged(key);
+            return;
         }
     }
-    return std::nullopt;
 }
 
-std::vector<Attribute> Instance::GetAttributes() { return Attributes; }
+const AttributeValue *
+Instance::GetAttribute(const std::string &attribute) const {
+    InternedString key;
+    if (!InternedString::Find(attribute, key))
+        return nullptr;
+
+    for (const auto &attr : Attributes)
+        if (attr.Name == key)
+            return &attr.Value;
+    return nullptr;
+}
+
+const std::vector<Attribute> &Instance::GetAttributes() const {
+    return Attributes;
+}
+
+Signal *Instance::GetAttributeChangedSignal(const std::string &attribute) {
+    InternedString key(attribute);
+    auto &signals = GetExtras().AttributeSignals;
+    for (auto &[name, signal] : signals)
+        if (name == key)
+            return signal.get();
+
+    signals.emplace_back(key, std::make_unique<Signal>());
+    return signals.back().second.get();
+}
+
+void Instance::FireAttributeChanged(const InternedString &attribute) {
+    AttributeChanged.Fire(attribute.str());
+    if (!Extras)
+        return;
+
+    for (auto &[name, signal] : Extras->AttributeSignals) {
+        if (name == attribute) {
+            signal->Fire();
+            break;
+        }
+    }
+}
 
 //------ Tags ------//
 
-void Instance::AddTag(std::string &tag) {
-    // TODO: implement tags
+void Instance::AddTag(const std::string &tag) {
+    if (HasTag(tag))
+        return;
+
+    InternedString key(tag);
+    Tags.push_back(key);
+    if (Tags.size() == 1)
+        AdjustTaggedSubtreeCount(1);
+    MarkSubtreeModified();
+    CollectionService::OnTagAdded(this, key);
 }
 
-bool Instance::HasTag(std::string &tag) {
-    // TODO: implement tag lookup
-    return false;
+bool Instance::HasTag(const std::string &tag) const {
+    InternedString key;
+    if (!InternedString::Find(tag, key))
+        return false;
+    return std::find(Tags.begin(), Tags.end(), key) != Tags.end();
+}
+
+void Instance::RemoveTag(const std::string &tag) {
+    InternedString key;
+    if (!InternedString::Find(tag, key))
+        return;
+
+    auto it = std::find(Tags.begin(), Tags.end(), key);
+    if (it == Tags.end())
+        return;
+
+    Tags.erase(it);
+    if (Tags.empty())
+        AdjustTaggedSubtreeCount(-1);
+    MarkSubtreeModified();
+    CollectionService::OnTagRemoved(this, key);
 }
 
-void Instance::RemoveTag(std::string &tag) {
-    // TODO: implement tag removal
+std::vector<std::string> Instance::GetTags() const {
+    return std::vector<std::string>(Tags.begin(), Tags.end());
+}
+
+void Instance::AdjustTaggedSubtreeCount(int64_t delta) {
+    for (Instance *node = this; node; node = node->Parent)
+        node->TaggedSubtreeCount = (uint32_t)(node->TaggedSubtreeCount + delta);
+}
+
+void Instance::SyncTagIndex() {
+    if (TaggedSubtreeCount)
+        CollectionService::SyncSubtree(this);
+}
+
+bool Instance::IsInDataModel() const {
+    const Instance *root = this;
+    while (root->Parent)
+        root = root->Parent;
+    return root == DataModel::Instance;
 }
 
 //------ Hierarchy ------//
 
-void Instance::SetParent(Instance *newParent) {
-    if (Parent == newParent)
+void Instance::LinkChild(Instance *child) {
+    child->Parent = this;
+    child->ChildOrder = NextChildOrder++;
+    child->PrevSibling = LastChild;
+    child->NextSibling = nullptr;
+
+    if (LastChild)
+        LastChild->NextSibling = child;
+    else
+        FirstChild = child;
+    LastChild = child;
+    ++ChildCount;
+
+    if (child->TaggedSubtreeCount)
+        AdjustTaggedSubtreeCount(child->TaggedSubtreeCount);
+
+    IndexChildName(child);
+    MarkSubtreeModified();
+
+    if (DescendantListenersInScope)
+        child->AdjustDescendantListenerScope(DescendantListenersInScope);
+}
+
+void Instance::UnlinkChild(Instance *child) {
+    if (InstanceCursor::ActiveHead)
+        InstanceCursor::OnUnlink(child);
+
+    UnindexChildName(child);
+
+    if (child->TaggedSubtreeCount)
+        AdjustTaggedSubtreeCount(-(int64_t)child->TaggedSubtreeCount);
+
+    if (child->PrevSibling)
+        child->PrevSibling->NextSibling = child->NextSibling;
+    else
+        FirstChild = child->NextSibling;
+
+    if (child->NextSibling)
+        child->NextSibling->PrevSibling = child->PrevSibling;
+    else
+        LastChild = child->PrevSibling;
+
+    child->PrevSibling = nullptr;
+    child->NextSibling = nullptr;
+    child->Parent = nullptr;
+    --ChildCount;
+    MarkSubtreeModified();
+
+    if (DescendantListenersInScope)
+        child->AdjustDescendantListenerScope(
+            -(int64_t)DescendantListenersInScope);
+}
+
+void Instance::IndexChildName(Instance *child) {
+    if (!ChildNameIndex) {
+        if (ChildCount < NameIndexThreshold)
+            return;
+
+        // Build the index from scratch once the container grows large enough
+        ChildNameIndex = std::make_unique<
+            std::unordered_map<InternedString, std::vector<Instance *>,
+                               InternedString::Hash>>();
+        for (Instance *c = FirstChild; c; c = c->NextSibling)
+            (*ChildNameIndex)[c->Name].push_back(c);
         return;
+    }
 
-    Instance *oldParent = Parent;
+    auto &bucket = (*ChildNameIndex)[child->Name];
+    if (bucket.empty() || bucket.back()->ChildOrder < child->ChildOrder) {
+        bucket.push_back(child);
+        return;
+    }
+
+    // Renamed children can land in the middle of a bucket
+    auto pos = std::upper_bound(bucket.begin(), bucket.end(), child,
+                                [](const Instance *a, const Instance *b) {
+                                    return a->ChildOrder < b->ChildOrder;
+                                });
+    bucket.insert(pos, child);
+}
+
+void Instance::UnindexChildName(Instance *child) {
+    if (!ChildNameIndex)
+        return;
+
+    auto it = ChildNameIndex->find(child->Name);
+    if (it == ChildNameIndex->end())
+        return;
+
+    auto &bucket = it->second;
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), child),
+                 bucket.end());
+    if (bucket.empty())
+        ChildNameIndex->erase(it);
+}
+
+void Instance::SetName(const std::string &name) {
+    if (Name == name)
+        return;
+
+    if (Parent)
+        Parent->UnindexChildName(this);
+    Name = name;
+    if (Parent)
+        Parent->IndexChildName(this);
+    MarkSubtreeModified();
+
+    if (Parent && Parent->Extras)
+        Parent->WakeChildWaiters(this);
+}
+
+void Instance::SetParent(Instance *newParent) {
+    // A destroyed instance stays parentless, and a service stays put
+    if (Parent == newParent || IsParentLocked())
+        return;
 
     if (Parent) {
-        auto &siblings = Parent->Children;
-        siblings.erase(std::remove(siblings.begin(), siblings.end(), this),
-                       siblings.end());
+        FireDescendantRemoving();
+        // A DescendantRemoving handler may have moved or destroyed it
+        if (Parent == newParent || Destroyed)
+            return;
     }
 
-    Parent = newParent;
+    Instance *oldParent = Parent;
+    Relink(newParent);
+    FireParentChanged(oldParent);
+}
+
+void Instance::Relink(Instance *newParent) {
+    if (Parent)
+        Parent->UnlinkChild(this);
+    if (newParent)
+        newParent->LinkChild(this);
+}
+
+void Instance::FireParentChanged(Instance *oldParent) {
+    SyncTagIndex();
 
-    if (newParent) {
-        newParent->Children.push_back(this);
-        newParent->ChildAdded.Fire(this);
-        newParent->DescendantAdded.Fire(this);
+    if (Parent) {
+        if (Parent->Extras)
+            Parent->WakeChildWaiters(this);
+        Parent->ChildAdded.Fire(this);
+        FireDescendantAdded();
     }
 
     AncestryChanged.Fire(this);
@@ -77,6 +454,197 @@ void Instance::SetParent(Instance *newParent) {
         oldParent->ChildRemoved.Fire(this);
 }
 
+// Filters a bulk list once: drops duplicates (keeping the first occurrence)
+// and anything skip rejects, so each instance's events fire at most once
+template <typename Skip>
+static std::vector<Instance *>
+CollectBulkTargets(const std::vector<Instance *> &instances, Skip skip) {
+    std::vector<Instance *> targets;
+    targets.reserve(instances.size());
+    std::unordered_set<Instance *> seen;
+    seen.reserve(instances.size());
+    for (Instance *inst : instances)
+        if (inst && seen.insert(inst).second && !skip(inst))
+            targets.push_back(inst);
+    return targets;
+}
+
+void Instance::BulkSetParent(const std::vector<Instance *> &instances,
+                             Instance *newParent) {
+    std::vector<Instance *> targets =
+        CollectBulkTargets(instances, [newParent](Instance *inst) {
+            if (inst->Parent == newParent || inst->IsParentLocked())
+                return true;
+            return newParent &&
+                   (inst == newParent || inst->IsAncestorOf(newParent));
+        });
+
+    for (Instance *inst : targets)
+        inst->FireDescendantRemoving();
+
+    // Apply every hierarchy change before any other listener runs
+    std::vector<std::pair<Instance *, Instance *>> moved;
+    moved.reserve(targets.size());
+    for (Instance *inst : targets) {
+        // A DescendantRemoving handler may have destroyed it
+        if (inst->Destroyed)
+            continue;
+
+        moved.emplace_back(inst, inst->Parent);
+        inst->Relink(newParent);
+    }
+
+    for (auto &[inst, oldParent] : moved)
+        inst->FireParentChanged(oldParent);
+}
+
+void Instance::BulkDestroy(const std::vector<Instance *> &instances) {
+    std::vector<Instance *> targets =
+        CollectBulkTargets(instances, [](Instance *inst) {
+            return inst->Destroyed || !inst->CanDestroy();
+        });
+
+    for (Instance *inst : targets)
+        inst->FireDescendantRemoving();
+
+    std::vector<std::pair<Instance *, Instance *>> detached;
+    detached.reserve(targets.size());
+    for (Instance *inst : targets) {
+        // A DescendantRemoving handler may have destroyed it already
+        if (inst->Destroyed)
+            continue;
+
+        detached.emplace_back(inst, inst->Parent);
+        inst->Relink(nullptr);
+    }
+
+    // Each instance is parentless now, so Destroy only tears down its subtree
+    for (auto &[inst, oldParent] : detached) {
+        inst->Destroy();
+        inst->SyncTagIndex();
+        if (oldParent)
+            oldParent->ChildRemoved.Fire(inst);
+    }
+}
+
+// Resolves a property write through the class's dispatch table; the key is
+// the interned Lua string, so this is a pointer-keyed probe
+static const PropertyDescriptor *
+CheckWritableProperty(lua_State *L, const Instance *inst, int keyIdx) {
+    if (lua_type(L, keyIdx) != LUA_TSTRING)
+        luaL_error(L, "property names must be strings, got %s",
+                   luaL_typename(L, keyIdx));
+
+    const char *key = lua_tostring(L, keyIdx);
+    const DispatchEntry *entry =
+        LuaClassBinder::FindMember(inst->ClassIndex, key);
+    if (!entry || !entry->setProperty)
+        luaL_error(L, "Unknown property '%s'", key);
+    if (entry->setProperty->readonly)
+        luaL_error(L, "Property '%s' is readonly", key);
+    return entry->setProperty;
+}
+
+void Instance::SetProperties(lua_State *L, int propertiesIdx) {
+    luaL_checktype(L, propertiesIdx, LUA_TTABLE);
+    int top = lua_gettop(L);
+
+    lua_pushnil(L);
+    while (lua_next(L, propertiesIdx)) {
+        const PropertyDescriptor *prop = CheckWritableProperty(L, this, -2);
+        prop->setter(L, this, top + 2);
+        lua_settop(L, top + 1); // keep the key for lua_next
+    }
+}
+
+void Instance::GetProperties(lua_State *L, int namesIdx) {
+    luaL_checktype(L, namesIdx, LUA_TTABLE);
+    int count = lua_objlen(L, namesIdx);
+
+    lua_createtable(L, 0, count);
+    int result = lua_gettop(L);
+    for (int i = 1; i <= count; ++i) {
+        lua_rawgeti(L, namesIdx, i);
+        if (lua_type(L, -1) != LUA_TSTRING)
+            luaL_error(L, "property names must be strings, got %s",
+                       luaL_typename(L, -1));
+
+        const char *key = lua_tostring(L, -1);
+        const DispatchEntry *entry =
+            LuaClassBinder::FindMember(ClassIndex, key);
+        if (!entry || !entry->getProperty)
+            luaL_error(L, "Unknown property '%s'", key);
+
+        entry->getProperty->getter(L, this);
+        lua_settop(L, result + 2);
+        lua_rawset(L, result);
+    }
+}
+
+void Instance::BulkSetProperties(lua_State *L, int instancesIdx,
+                                 int propertiesIdx) {
+    std::vector<Instance *> instances =
+        LuaClassBinder::CheckInstanceList(L, instancesIdx);
+    luaL_checktype(L, propertiesIdx, LUA_TTABLE);
+    int top = lua_gettop(L);
+
+    lua_pushnil(L);
+    while (lua_next(L, propertiesIdx)) {
+        // Stack: key at top + 1, value array at top + 2
+        luaL_checktype(L, top + 2, LUA_TTABLE);
+
+        // Resolve once per class rather than once per instance
+        ClassId resolvedClass = kInvalidClassId;
+        const PropertyDescriptor *prop = nullptr;
+        for (size_t i = 0; i < instances.size(); ++i) {
+            Instance *inst = instances[i];
+            if (inst->ClassIndex != resolvedClass) {
+                prop = CheckWritableProperty(L, inst, top + 1);
+                resolvedClass = inst->ClassIndex;
+            }
+
+            lua_rawgeti(L, top + 2, (int)i + 1);
+            prop->setter(L, inst, top + 3);
+            lua_settop(L, top + 2);
+        }
+
+        lua_settop(L, top + 1);
+    }
+}
+
+void Instance::GetPropertyInfo(lua_State *L, const std::string &className) {
+    ClassId classId = ClassRegistry::FindClassId(className);
+    const std::vector<PropertyInfo> &properties =
+        PropertyReflection::GetProperties(classId);
+    if (properties.empty())
+        luaL_error(L, "'%s' is not a bound class", className.c_str());
+
+    lua_createtable(L, (int)properties.size(), 0);
+    for (size_t i = 0; i < properties.size(); ++i) {
+        const PropertyInfo &info = properties[i];
+        lua_createtable(L, 0, 5);
+
+        lua_pushlstring(L, info.Name.data(), info.Name.size());
+        lua_setfield(L, -2, "Name");
+
+        const std::string &owner = ClassRegistry::GetClassName(info.Owner);
+        lua_pushlstring(L, owner.data(), owner.size());
+        lua_setfield(L, -2, "Class");
+
+        lua_pushboolean(L, info.ReadOnly);
+        lua_setfield(L, -2, "ReadOnly");
+
+        if (const char *type = FieldTypeName(info.Type)) {
+            lua_pushstring(L, type);
+            lua_setfield(L, -2, "Type");
+            PropertyReflection::PushValue(L, info.Default);
+            lua_setfield(L, -2, "Default");
+        }
+
+        lua_rawseti(L, -2, (int)i + 1);
+    }
+}
+
 void Instance::AddChild(Instance *child) {
     if (!child || child == this)
         return;
@@ -84,37 +652,83 @@ void Instance::AddChild(Instance *child) {
 }
 
 void Instance::RemoveChild(Instance *child) {
-    if (!child)
+    if (!child || child->Parent != this)
         return;
 
-    auto it = std::remove(Children.begin(), Children.end(), child);
-    if (it != Children.end()) {
-        Children.erase(it, Children.end());
-        child->Parent = nullptr;
-        ChildRemoved.Fire(child);
-    }
+    child->FireDescendantRemoving();
+    // A DescendantRemoving handler may have moved it already
+    if (child->Parent != this)
+        return;
+
+    UnlinkChild(child);
+    child->SyncTagIndex();
+    ChildRemoved.Fire(child);
 }
 
 void Instance::Destroy() {
+    if (CanDestroy())
+        DestroyTree();
+}
+
+void Instance::DestroyTree() {
+    if (Destroyed)
+        return;
+    Destroyed = true;
+
     Destroying.Fire(this);
 
-    for (auto *child : Children) {
-        if (child)
-            child->Destroy();
+    // Each child unlinks itself as it is destroyed. Services only go down
+    // with the DataModel, at shutdown.
+    while (LastChild)
+        LastChild->DestroyTree();
+
+    if (InstanceCursor::ActiveHead)
+        InstanceCursor::OnDestroy(this);
+
+    ChildNameIndex.reset();
+    DropQueryCache();
+    // Nothing can appear any more, so waiting tasks get nil now rather than
+    // staying parked until their timeout, or forever without one
+    if (Extras) {
+        for (const ChildWaiter &waiter : Extras->ChildWaiters) {
+            lua_pushnil(waiter.Thread);
+            Task_Wake(waiter.Thread, waiter.ParkId, 1);
+        }
+        Extras->ChildWaiters.clear();
     }
 
-    Children.clear();
+    // Stays allocated while Lua holds it, but is no longer drawn
+    if (auto *part = As<BasePart>())
+        RemoveFromRenderList(part);
 
     if (Parent)
         Parent->RemoveChild(this);
 
-    Parent = nullptr;
+    // Handlers that capture this instance would otherwise keep it alive
+    Changed.DisconnectAll();
+    AncestryChanged.DisconnectAll();
+    AttributeChanged.DisconnectAll();
+    ChildAdded.DisconnectAll();
+    ChildRemoved.DisconnectAll();
+    DescendantAdded.DisconnectAll();
+    DescendantRemoving.DisconnectAll();
+    Destroying.DisconnectAll();
+    if (Extras) {
+        for (auto &[name, signal] : Extras->AttributeSignals)
+            signal->DisconnectAll();
+    }
+
+    QueueFree();
 }
 
 std::optional<Instance *> Instance::FindFirstAncestor(std::string &name) {
+    InternedString key;
+    if (!InternedString::Find(name, key))
+        return std::nullopt;
+
     Instance *current = Parent;
     while (current) {
-        if (current->Name == name)
+        if (current->Name == key)
             return current;
         current = current->Parent;
     }
@@ -123,9 +737,13 @@ std::optional<Instance *> Instance::FindFirstAncestor(std::string &name) {
 
 std::optional<Instance *>
 Instance::FindFirstAncestorOfClass(std::string &className) {
+    ClassId classId = ClassRegistry::FindClassId(className);
+    if (classId == kInvalidClassId)
+        return std::nullopt;
+
     Instance *current = Parent;
     while (current) {
-        if (current->ClassName == className)
+        if (current->ClassIndex == classId)
             return current;
         current = current->Parent;
     }
@@ -134,9 +752,13 @@ Instance::FindFirstAncestorOfClass(std::string &className) {
 
 std::optional<Instance *>
 Instance::FindFirstAncestorWhichIsA(std::string &className) {
+    ClassId classId = ClassRegistry::FindClassId(className);
+    if (classId == kInvalidClassId)
+        return std::nullopt;
+
     Instance *current = Parent;
     while (current) {
-        if (current->IsA(className))
+        if (current->IsA(classId))
             return current;
         current = current->Parent;
     }
@@ -144,55 +766,286 @@ Instance::FindFirstAncestorWhichIsA(std::string &className) {
 }
 
 std::optional<Instance *> Instance::FindFirstChild(std::string &name) {
-    for (auto *child : Children)
+    // A name that was never interned cannot belong to any instance
+    InternedString key;
+    if (!InternedString::Find(name, key))
+        return std::nullopt;
+
+    if (Instance *child = FindChildByName(key))
+        return child;
+    return std::nullopt;
+}
+
+Instance *Instance::FindChildByName(const InternedString &name) const {
+    if (ChildNameIndex) {
+        auto it = ChildNameIndex->find(name);
+        return it != ChildNameIndex->end() ? it->second.front() : nullptr;
+    }
+
+    for (Instance *child = FirstChild; child; child = child->NextSibling)
         if (child->Name == name)
             return child;
-    return std::nullopt;
+    return nullptr;
 }
 
 std::optional<Instance *>
 Instance::FindFirstChildOfClass(std::string &className) {
-    for (auto *child : Children)
-        if (child->ClassName == className)
+    ClassId classId = ClassRegistry::FindClassId(className);
+    if (classId == kInvalidClassId)
+        return std::nullopt;
+
+    for (Instance *child = FirstChild; child; child = child->NextSibling)
+        if (child->ClassIndex == classId)
             return child;
     return std::nullopt;
 }
 
 std::optional<Instance *>
 Instance::FindFirstChildWhichIsA(std::string &className) {
-    for (auto *child : Children)
-        if (child->IsA(className))
+    ClassId classId = ClassRegistry::FindClassId(className);
+    if (classId == kInvalidClassId)
+        return std::nullopt;
+
+    for (Instance *child = FirstChild; child; child = child->NextSibling)
+        if (child->IsA(classId))
             return child;
     return std::nullopt;
 }
 
 std::optional<Instance *> Instance::FindFirstDescendant(std::string &name) {
-    for (auto *child : Children) {
-        if (child->Name == name)
-            return child;
-        auto result = child->FindFirstDescendant(name);
-        if (result)
-            return result;
-    }
+    InternedString key;
+    if (!InternedString::Find(name, key))
+        return std::nullopt;
+
+    // Depth-first pre-order; interned names compare by pointer, and the
+    // sibling links make the walk allocation-free
+    for (Instance *current = FirstChild; current;
+         current = GetNextDescendant(current))
+        if (current->Name == key)
+            return current;
     return std::nullopt;
 }
 
-std::vector<Instance *> Instance::GetChildren() { return Children; }
+std::vector<Instance *> Instance::GetChildren() {
+    std::vector<Instance *> children;
+    children.reserve(ChildCount);
+    for (Instance *child = FirstChild; child; child = child->NextSibling)
+        children.push_back(child);
+    return children;
+}
 
 std::vector<Instance *> Instance::GetDescendants() {
     std::vector<Instance *> descendants;
-    std::vector<Instance *> stack = Children;
+    for (Instance *current = FirstChild; current;
+         current = GetNextDescendant(current))
+        descendants.push_back(current);
+    return descendants;
+}
 
-    while (!stack.empty()) {
-        Instance *current = stack.back();
-        stack.pop_back();
+InstanceCursor Instance::IterChildren() { return InstanceCursor(this, false); }
 
-        descendants.push_back(current);
-        for (auto *child : current->Children)
-            stack.push_back(child);
+InstanceCursor Instance::IterDescendants() {
+    return InstanceCursor(this, true);
+}
+
+//------ WaitForChild ------//
+
+int Instance::WaitForChild(lua_State *L) {
+    std::string name = luaL_checkstring(L, 2);
+    double timeout = luaL_optnumber(L, 3, -1.0);
+
+    auto result = FindFirstChild(name);
+    if (result.has_value()) {
+        LuaClassBinder::PushInstance(L, result.value());
+        return 1;
     }
 
-    return descendants;
+    // The instance may be freed before the timeout, so go through its handle
+    InstanceHandle handle = Handle;
+    uint64_t parkId = Task_Park(L, timeout, [handle](uint64_t timedOut) {
+        if (Instance *inst = InstanceTable::Resolve(handle))
+            inst->RemoveChildWaiter(timedOut);
+    });
+    if (!parkId)
+        luaL_error(L, "attempted to use WaitForChild outside of a running task");
+
+    AddChildWaiter(InternedString(name), L, parkId);
+    return lua_yield(L, 0);
+}
+
+void Instance::AddChildWaiter(const InternedString &name, lua_State *thread,
+                              uint64_t parkId) {
+    GetExtras().ChildWaiters.push_back({name, thread, parkId});
+}
+
+void Instance::WakeChildWaiters(Instance *child) {
+    auto &pending = Extras->ChildWaiters;
+    if (pending.empty())
+        return;
+
+    // Take the list first: a woken task may wait on this instance again
+    auto waiters = std::move(pending);
+    pending.clear();
+
+    for (const ChildWaiter &waiter : waiters) {
+        if (waiter.Name != child->Name) {
+            pending.push_back(waiter);
+            continue;
+        }
+        LuaClassBinder::PushInstance(waiter.Thread, child);
+        Task_Wake(waiter.Thread, waiter.ParkId, 1);
+    }
+}
+
+void Instance::RemoveChildWaiter(uint64_t parkId) {
+    if (!Extras)
+        return;
+
+    auto &waiters = Extras->ChildWaiters;
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                 [parkId](const ChildWaiter &waiter) {
+                                     return waiter.ParkId == parkId;
+                                 }),
+                  waiters.end());
+}
+
+//------ Descendant events ------//
+
+void Instance::HookDescendantSignals() {
+    // However a handler connects, the listener count stays current
+    auto recount = [](Instance *owner) {
+        owner->UpdateDescendantListenerCount();
+    };
+    DescendantAdded.OnConnectionsChanged = recount;
+    DescendantAdded.Owner = this;
+    DescendantRemoving.OnConnectionsChanged = recount;
+    DescendantRemoving.Owner = this;
+}
+
+void Instance::UpdateDescendantListenerCount() {
+    uint32_t count = (uint32_t)(DescendantAdded.LuaConnections.size() +
+                                DescendantAdded.CppConnections.size() +
+                                DescendantRemoving.LuaConnections.size() +
+                                DescendantRemoving.CppConnections.size());
+    uint32_t previous = Extras ? Extras->DescendantListeners : 0;
+    if (count == previous)
+        return;
+
+    int64_t delta = (int64_t)count - (int64_t)previous;
+    GetExtras().DescendantListeners = count;
+    AdjustDescendantListenerScope(delta);
+}
+
+void Instance::AdjustDescendantListenerScope(int64_t delta) {
+    DescendantListenersInScope =
+        (uint32_t)(DescendantListenersInScope + delta);
+    for (Instance *current = FirstChild; current;
+         current = GetNextDescendant(current))
+        current->DescendantListenersInScope =
+            (uint32_t)(current->DescendantListenersInScope + delta);
+}
+
+// Instances in this subtree, this one first. Snapshotted so handlers can
+// change the tree while events fire.
+static std::vector<Instance *> CollectSubtree(Instance *root) {
+    std::vector<Instance *> subtree{root};
+    for (Instance *current = root->FirstChild; current;
+         current = root->GetNextDescendant(current))
+        subtree.push_back(current);
+    return subtree;
+}
+
+void Instance::FireDescendantAdded() {
+    if (!Parent || !Parent->DescendantListenersInScope)
+        return;
+
+    for (Instance *added : CollectSubtree(this)) {
+        // Ancestors above the first one with nothing in scope never listen
+        for (Instance *ancestor = Parent;
+             ancestor && ancestor->DescendantListenersInScope;
+             ancestor = ancestor->Parent)
+            if (ancestor->Extras && ancestor->Extras->DescendantListeners)
+                ancestor->DescendantAdded.Fire(added);
+    }
+}
+
+void Instance::FireDescendantRemoving() {
+    if (!Parent || !Parent->DescendantListenersInScope)
+        return;
+
+    for (Instance *removing : CollectSubtree(this)) {
+        for (Instance *ancestor = Parent;
+             ancestor && ancestor->DescendantListenersInScope;
+             ancestor = ancestor->Parent)
+            if (ancestor->Extras && ancestor->Extras->DescendantListeners)
+                ancestor->DescendantRemoving.Fire(removing);
+    }
+}
+
+//------ Queries ------//
+
+void Instance::MarkSubtreeModified() {
+    if (s_queryCacheCount == 0)
+        return;
+
+    uint64_t epoch = ++s_modificationEpoch;
+    // Only instances holding a cache ever read their epoch
+    for (Instance *node = this; node; node = node->Parent)
+        if (node->Extras)
+            node->Extras->SubtreeEpoch = epoch;
+}
+
+void Instance::DropQueryCache() {
+    if (!Extras || Extras->QueryCache.empty())
+        return;
+    Extras->QueryCache = {};
+    --s_queryCacheCount;
+}
+
+const std::vector<Instance *> &
+Instance::QueryDescendants(const std::shared_ptr<const InstanceQuery> &query) {
+    InstanceExtras &extras = GetExtras();
+    auto &cache = extras.QueryCache;
+    if (cache.empty())
+        ++s_queryCacheCount;
+
+    QueryCacheEntry *entry = nullptr;
+    for (auto &cached : cache) {
+        if (cached.Query == query) {
+            if (cached.Epoch == extras.SubtreeEpoch)
+                return cached.Results;
+            entry = &cached;
+            break;
+        }
+    }
+
+    if (!entry) {
+        if (cache.size() >= MaxCachedQueries)
+            cache.erase(cache.begin());
+        cache.push_back({query, 0, {}});
+        entry = &cache.back();
+    }
+
+    entry->Epoch = extras.SubtreeEpoch;
+    entry->Results.clear();
+    for (Instance *current = FirstChild; current;
+         current = GetNextDescendant(current))
+        if (query->Matches(current))
+            entry->Results.push_back(current);
+    return entry->Results;
+}
+
+Instance *Instance::GetNextDescendant(Instance *current) const {
+    if (current->FirstChild)
+        return current->FirstChild;
+
+    // Climb until some ancestor below this one has a next sibling
+    while (current && current != this) {
+        if (current->NextSibling)
+            return current->NextSibling;
+        current = current->Parent;
+    }
+    return nullptr;
 }
 
 bool Instance::IsAncestorOf(Instance *descendant) {
@@ -215,44 +1068,131 @@ bool Instance::IsDescendantOf(Instance *ancestor) {
 }
 
 void Instance::ClearAllChildren() {
-    for (auto *child : Children) {
-        if (child)
+    // Services refuse to be destroyed, so walk a snapshot rather than
+    // destroying the last child until none is left
+    std::vector<Instance *> children;
+    children.reserve(ChildCount);
+    for (Instance *child = FirstChild; child; child = child->NextSibling)
+        children.push_back(child);
+
+    // Handlers may move or destroy later children; they are freed no
+    // earlier than the end of the scheduler step
+    for (Instance *child : children)
+        if (child->Parent == this)
             child->Destroy();
+
+    if (!FirstChild)
+        ChildNameIndex.reset();
+}
+
+// Bind
+
+static void PushAttributeValue(lua_State *L, const AttributeValue &value) {
+    if (auto *b = std::get_if<bool>(&value)) {
+        lua_pushboolean(L, *b);
+    } else if (auto *d = std::get_if<double>(&value)) {
+        lua_pushnumber(L, *d);
+    } else if (auto *str = std::get_if<std::string>(&value)) {
+        lua_pushlstring(L, str->data(), str->size());
+    } else if (auto *v = std::get_if<Vector3Game>(&value)) {
+        Vector3Game_Push(L, *v);
+    } else {
+        Color3_Push(L, std::get<Color3>(value));
     }
-    Children.clear();
 }
 
-bool Instance::IsA(const std::string &className) const {
-    if (className == "Instance")
-        return true;
-    return this->ClassName == className || Object::IsA(className);
+static AttributeValue CheckAttributeValue(lua_State *L, int idx) {
+    switch (lua_type(L, idx)) {
+    case LUA_TBOOLEAN:
+        return (bool)lua_toboolean(L, idx);
+    case LUA_TNUMBER:
+        return (double)lua_tonumber(L, idx);
+    case LUA_TSTRING: {
+        size_t len = 0;
+        const char *str = lua_tolstring(L, idx, &len);
+        return std::string(str, len);
+    }
+    case LUA_TVECTOR:
+        return Vector3Game_Check(L, idx);
+    case LUA_TLIGHTUSERDATA: {
+        Color3 c;
+        if (Color3_Test(L, idx, c))
+            return c;
+        break;
+    }
+    }
+
+    luaL_error(L, "%s is not a supported attribute type",
+               luaL_typename(L, idx));
+    return false;
 }
 
-// Bind
+// Accept both Instance.Bulk*(list, ...) and Instance:Bulk*(list, ...)
+static int BulkArgStart(lua_State *L) { return lua_istable(L, 2) ? 2 : 1; }
+
+static int Instance_BulkSetParent(lua_State *L) {
+    int arg = BulkArgStart(L);
+    std::vector<Instance *> instances =
+        LuaClassBinder::CheckInstanceList(L, arg);
+    Instance *newParent = lua_isnoneornil(L, arg + 1)
+                              ? nullptr
+                              : LuaClassBinder::CheckInstance(L, arg + 1);
+    Instance::BulkSetParent(instances, newParent);
+    return 0;
+}
+
+static int Instance_BulkDestroy(lua_State *L) {
+    Instance::BulkDestroy(
+        LuaClassBinder::CheckInstanceList(L, BulkArgStart(L)));
+    return 0;
+}
+
+static int Instance_BulkSetProperties(lua_State *L) {
+    // Both arguments are tables, so a third one means the method form
+    int arg = lua_istable(L, 3) ? 2 : 1;
+    Instance::BulkSetProperties(L, arg, arg + 1);
+    return 0;
+}
+
+static int Instance_GetPropertyInfo(lua_State *L) {
+    int arg = lua_istable(L, 1) ? 2 : 1;
+    Instance::GetPropertyInfo(L, luaL_checkstring(L, arg));
+    return 1;
+}
 
 void Class_Instance_Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("Instance", "Object");
 
+    LuaClassBinder::AddStaticFunction("BulkSetParent", Instance_BulkSetParent);
+    LuaClassBinder::AddStaticFunction("BulkDestroy", Instance_BulkDestroy);
+    LuaClassBinder::AddStaticFunction("BulkSetProperties",
+                                      Instance_BulkSetProperties);
+    LuaClassBinder::AddStaticFunction("GetPropertyInfo",
+                                      Instance_GetPropertyInfo);
+
     // Properties
     LuaClassBinder::AddProperty(
         "Instance", "Name",
         [](lua_State *L, Instance *inst) -> int {
-            lua_pushstring(L, inst->Name.c_str());
+            lua_pushlstring(L, inst->Name.c_str(), inst->Name.size());
             return 1;
         },
         [](lua_State *L, Instance *inst, int valueIdx) -> int {
-            inst->Name = luaL_checkstring(L, valueIdx);
+            inst->SetName(luaL_checkstring(L, valueIdx));
             return 0;
         });
 
     LuaClassBinder::AddProperty(
         "Instance", "ClassName",
         [](lua_State *L, Instance *inst) -> int {
-            lua_pushstring(L, inst->ClassName.c_str());
+            lua_pushlstring(L, inst->ClassName.c_str(),
+                            inst->ClassName.size());
             return 1;
         },
         nullptr); // Read-only
 
+    LuaClassBinder::AddField<&Instance::Archivable>("Archivable");
+
     LuaClassBinder::AddProperty(
         "Instance", "Parent",
         [](lua_State *L, Instance *inst) -> int {
@@ -264,6 +1204,13 @@ void Class_Instance_Bind(lua_State *L) {
             return 1;
         },
         [](lua_State *L, Instance *inst, int valueIdx) -> int {
+            if (inst->IsParentLocked())
+                luaL_error(L,
+                           "The Parent property of %s is locked, current "
+                           "parent: %s",
+                           inst->Name.c_str(),
+                           inst->Parent ? inst->Parent->Name.c_str() : "NULL");
+
             if (lua_isnil(L, valueIdx)) {
                 inst->SetParent(nullptr);
             } else {
@@ -282,30 +1229,86 @@ void Class_Instance_Bind(lua_State *L) {
             return 1;
         });
 
-    LuaClassBinder::AddMethod("Instance", "GetChildren",
-                              [](lua_State *L, Instance *inst) -> int {
-                                  lua_newtable(L);
-                                  int i = 1;
-                                  for (Instance *child : inst->GetChildren()) {
-                                      lua_pushinteger(L, i++);
-                                      LuaClassBinder::PushInstance(L, child);
-                                      lua_settable(L, -3);
-                                  }
-                                  return 1;
-                              });
+    LuaClassBinder::AddMethod(
+        "Instance", "GetChildren", [](lua_State *L, Instance *inst) -> int {
+            lua_createtable(L, (int)inst->ChildCount, 0);
+            int i = 1;
+            for (Instance *child = inst->FirstChild; child;
+                 child = child->NextSibling) {
+                LuaClassBinder::PushInstance(L, child);
+                lua_rawseti(L, -2, i++);
+            }
+            return 1;
+        });
 
     LuaClassBinder::AddMethod(
         "Instance", "GetDescendants", [](lua_State *L, Instance *inst) -> int {
             lua_newtable(L);
             int i = 1;
-            for (Instance *descendant : inst->GetDescendants()) {
-                lua_pushinteger(L, i++);
+            for (Instance *descendant = inst->FirstChild; descendant;
+                 descendant = inst->GetNextDescendant(descendant)) {
                 LuaClassBinder::PushInstance(L, descendant);
-                lua_settable(L, -3);
+                lua_rawseti(L, -2, i++);
+            }
+            return 1;
+        });
+
+    LuaClassBinder::AddProperty(
+        "Instance", "DescendantAdded",
+        [](lua_State *L, Instance *inst) -> int {
+            Lua_PushSignal(L, &inst->DescendantAdded, inst);
+            return 1;
+        });
+
+    LuaClassBinder::AddProperty(
+        "Instance", "DescendantRemoving",
+        [](lua_State *L, Instance *inst) -> int {
+            Lua_PushSignal(L, &inst->DescendantRemoving, inst);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "SetProperties", [](lua_State *L, Instance *inst) -> int {
+            inst->SetProperties(L, 2);
+            return 0;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "GetProperties", [](lua_State *L, Instance *inst) -> int {
+            inst->GetProperties(L, 2);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "QueryDescendants",
+        [](lua_State *L, Instance *inst) -> int {
+            std::string error;
+            InstanceQuery::Ptr query =
+                InstanceQuery::Compile(luaL_checkstring(L, 2), error);
+            if (!query)
+                luaL_error(L, "QueryDescendants: %s", error.c_str());
+
+            const auto &results = inst->QueryDescendants(query);
+            lua_createtable(L, (int)results.size(), 0);
+            for (size_t i = 0; i < results.size(); ++i) {
+                LuaClassBinder::PushInstance(L, results[i]);
+                lua_rawseti(L, -2, (int)i + 1);
             }
             return 1;
         });
 
+    LuaClassBinder::AddMethod(
+        "Instance", "IterChildren", [](lua_State *L, Instance *inst) -> int {
+            InstanceCursor::Push(L, inst, false);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "IterDescendants", [](lua_State *L, Instance *inst) -> int {
+            InstanceCursor::Push(L, inst, true);
+            return 1;
+        });
+
     LuaClassBinder::AddMethod(
         "Instance", "FindFirstChild", [](lua_State *L, Instance *inst) -> int {
             std::string name = luaL_checkstring(L, 2);
@@ -318,6 +1321,24 @@ void Class_Instance_Bind(lua_State *L) {
             return 1;
         });
 
+    LuaClassBinder::AddMethod(
+        "Instance", "WaitForChild", [](lua_State *L, Instance *inst) -> int {
+            return inst->WaitForChild(L);
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "FindFirstDescendant",
+        [](lua_State *L, Instance *inst) -> int {
+            std::string name = luaL_checkstring(L, 2);
+            auto result = inst->FindFirstDescendant(name);
+            if (result.has_value()) {
+                LuaClassBinder::PushInstance(L, result.value());
+            } else {
+                lua_pushnil(L);
+            }
+            return 1;
+        });
+
     LuaClassBinder::AddMethod(
         "Instance", "FindFirstChildWhichIsA",
         [](lua_State *L, Instance *inst) -> int {
@@ -331,11 +1352,13 @@ void Class_Instance_Bind(lua_State *L) {
             return 1;
         });
 
-    LuaClassBinder::AddMethod("Instance", "Destroy",
-                              [](lua_State *L, Instance *inst) -> int {
-                                  inst->Destroy();
-                                  return 0;
-                              });
+    LuaClassBinder::AddMethod(
+        "Instance", "Destroy", [](lua_State *L, Instance *inst) -> int {
+            if (!inst->CanDestroy())
+                luaL_error(L, "%s cannot be destroyed", inst->Name.c_str());
+            inst->Destroy();
+            return 0;
+        });
 
     LuaClassBinder::AddMethod("Instance", "ClearAllChildren",
                               [](lua_State *L, Instance *inst) -> int {
@@ -356,4 +1379,84 @@ void Class_Instance_Bind(lua_State *L) {
             lua_pushboolean(L, inst->IsDescendantOf(ancestor));
             return 1;
         });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "Clone", [](lua_State *L, Instance *inst) -> int {
+            Instance *clone = inst->Clone();
+            if (clone)
+                LuaClassBinder::PushInstance(L, clone);
+            else
+                lua_pushnil(L);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "GetAttribute", [](lua_State *L, Instance *inst) -> int {
+            const AttributeValue *value =
+                inst->GetAttribute(luaL_checkstring(L, 2));
+            if (value)
+                PushAttributeValue(L, *value);
+            else
+                lua_pushnil(L);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "SetAttribute", [](lua_State *L, Instance *inst) -> int {
+            const char *name = luaL_checkstring(L, 2);
+            if (lua_isnoneornil(L, 3))
+                inst->RemoveAttribute(name);
+            else
+                inst->SetAttribute(name, CheckAttributeValue(L, 3));
+            return 0;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "GetAttributes", [](lua_State *L, Instance *inst) -> int {
+            const auto &attributes = inst->GetAttributes();
+            lua_createtable(L, 0, (int)attributes.size());
+            for (const auto &attr : attributes) {
+                lua_pushlstring(L, attr.Name.c_str(), attr.Name.size());
+                PushAttributeValue(L, attr.Value);
+                lua_rawset(L, -3);
+            }
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "GetAttributeChangedSignal",
+        [](lua_State *L, Instance *inst) -> int {
+            const char *name = luaL_checkstring(L, 2);
+            Lua_PushSignal(L, inst->GetAttributeChangedSignal(name), inst);
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod("Instance", "AddTag",
+                              [](lua_State *L, Instance *inst) -> int {
+                                  inst->AddTag(luaL_checkstring(L, 2));
+                                  return 0;
+                              });
+
+    LuaClassBinder::AddMethod("Instance", "RemoveTag",
+                              [](lua_State *L, Instance *inst) -> int {
+                                  inst->RemoveTag(luaL_checkstring(L, 2));
+                                  return 0;
+                              });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "HasTag", [](lua_State *L, Instance *inst) -> int {
+            lua_pushboolean(L, inst->HasTag(luaL_checkstring(L, 2)));
+            return 1;
+        });
+
+    LuaClassBinder::AddMethod(
+        "Instance", "GetTags", [](lua_State *L, Instance *inst) -> int {
+            lua_createtable(L, (int)inst->Tags.size(), 0);
+            for (size_t i = 0; i < inst->Tags.size(); ++i) {
+                const InternedString &tag = inst->Tags[i];
+                lua_pushlstring(L, tag.c_str(), tag.size());
+                lua_rawseti(L, -2, (int)i + 1);
+            }
+            return 1;
+        });
 }
\ No newline at end of file
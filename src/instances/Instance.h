@@ -1,18 +1,63 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "../core/InstanceTable.h"
 #include "../core/Signal.h"
 #include "../datatypes/Color3.h"
 #include "../datatypes/Vector3.h"
+#include "InstanceCursor.h"
 #include "Object.h"
 
+using AttributeValue =
+    std::variant<bool, double, std::string, Vector3Game, Color3>;
+
 struct Attribute {
-    std::string Name;
-    std::variant<bool, double, std::string, Vector3Game, Color3> Value;
+    InternedString Name;
+    AttributeValue Value;
+};
+
+struct Instance;
+struct InstanceQuery;
+
+struct QueryCacheEntry {
+    std::shared_ptr<const InstanceQuery> Query;
+    uint64_t Epoch;
+    std::vector<Instance *> Results;
+};
+
+// A Lua task parked in WaitForChild until a child with Name appears
+struct ChildWaiter {
+    InternedString Name;
+    lua_State *Thread;
+    uint64_t ParkId;
+};
+
+// Per-instance state that most instances never touch, kept behind one
+// pointer so it costs nothing until first used
+struct InstanceExtras {
+    // Per-attribute changed signals, created on first request
+    std::vector<std::pair<InternedString, std::unique_ptr<Signal>>>
+        AttributeSignals;
+
+    // Changes whenever this instance or a descendant is reparented, renamed,
+    // retagged or has an attribute set, while any query cache exists. Query
+    // results cached at the same epoch are still valid.
+    uint64_t SubtreeEpoch = 0;
+
+    // Results of recent QueryDescendants calls
+    std::vector<QueryCacheEntry> QueryCache;
+
+    // Tasks parked in WaitForChild on this instance
+    std::vector<ChildWaiter> ChildWaiters;
+
+    // Connections on this instance's DescendantAdded and DescendantRemoving
+    uint32_t DescendantListeners = 0;
 };
 
 /**
@@ -28,6 +73,8 @@ struct Attribute {
  *
  */
 struct Instance : public Object {
+    static constexpr const char *StaticClassName = "Instance";
+
     //-- Properties --//
 
     /**
@@ -38,9 +85,114 @@ struct Instance : public Object {
      */
     Instance *Parent = nullptr;
 
-    std::vector<Instance *> Children;
+    /**
+     * @property FirstChild
+     * @internal
+     * @type Instance | nil
+     * @description Head of the intrusive child list, in child order
+     */
+    Instance *FirstChild = nullptr;
+
+    /**
+     * @property LastChild
+     * @internal
+     * @type Instance | nil
+     * @description Tail of the intrusive child list
+     */
+    Instance *LastChild = nullptr;
+
+    /**
+     * @property PrevSibling
+     * @internal
+     * @type Instance | nil
+     * @description Previous child of Parent, or nil if this is the first
+     */
+    Instance *PrevSibling = nullptr;
+
+    /**
+     * @property NextSibling
+     * @internal
+     * @type Instance | nil
+     * @description Next child of Parent, or nil if this is the last
+     */
+    Instance *NextSibling = nullptr;
+
+    /**
+     * @property ChildCount
+     * @internal
+     * @type number
+     * @description Number of direct children
+     */
+    size_t ChildCount = 0;
+
+    /**
+     * @property Attributes
+     * @internal
+     * @type table
+     * @description Flat map of attributes in the order they were first set.
+     * Keys are interned, so lookups compare pointers.
+     */
     std::vector<Attribute> Attributes;
 
+    /**
+     * @property ChildNameIndex
+     * @internal
+     * @type table
+     * @description Name to children lookup, built once this instance has
+     * NameIndexThreshold children. Each bucket is kept in child order.
+     */
+    std::unique_ptr<std::unordered_map<InternedString, std::vector<Instance *>,
+                                       InternedString::Hash>>
+        ChildNameIndex;
+
+    /**
+     * @property ChildOrder
+     * @internal
+     * @type number
+     * @description Position of this instance among its siblings, used to keep
+     * name index buckets in child order
+     */
+    uint64_t ChildOrder = 0;
+
+    /**
+     * @property NextChildOrder
+     * @internal
+     * @type number
+     * @description Order value handed to the next child attached here
+     */
+    uint64_t NextChildOrder = 0;
+
+    static constexpr size_t NameIndexThreshold = 32;
+
+    /**
+     * @property Tags
+     * @internal
+     * @type table
+     * @description Tags on this instance, in the order added
+     */
+    std::vector<InternedString> Tags;
+
+    /**
+     * @property TaggedSubtreeCount
+     * @internal
+     * @type number
+     * @description Number of tagged instances in this subtree, including
+     * this one. Lets tag index updates skip untagged branches.
+     */
+    uint32_t TaggedSubtreeCount = 0;
+
+    /**
+     * @property Extras
+     * @internal
+     * @type InstanceExtras
+     * @description Attribute signals, query cache, WaitForChild waiters and
+     * descendant listener count, allocated on first use. Most instances
+     * never need any of them.
+     */
+    std::unique_ptr<InstanceExtras> Extras;
+
+    static constexpr size_t MaxCachedQueries = 8;
+
     /**
      * @property Archivable
      * @type bool
@@ -50,12 +202,30 @@ struct Instance : public Object {
     bool Archivable = true;
 
     /**
-     * @property Name
-     * @type string
-     * @default ClassName
-     * @description The name of this instance
+     * @property Handle
+     * @internal
+     * @type InstanceHandle
+     * @description Slot and generation in InstanceTable. Lua userdata store
+     * this instead of a pointer.
+     */
+    InstanceHandle Handle;
+
+    /**
+     * @property Destroyed
+     * @internal
+     * @type bool
+     * @description Set by Destroy. The instance stays usable with its Parent
+     * locked until the next scheduler step frees it.
      */
-    std::string Name = ClassName;
+    bool Destroyed = false;
+
+    /**
+     * @property QueuedForFree
+     * @internal
+     * @type bool
+     * @description True while this instance sits in the free queue
+     */
+    bool QueuedForFree = false;
 
     //-- Events --//
 
@@ -91,17 +261,30 @@ struct Instance : public Object {
     /**
      * @event DescendantAdded
      * @param descendant Instance
-     * @description Fires when a descendant is added anywhere in the tree
+     * @description Fires when a descendant is added anywhere in the tree,
+     * once for the added instance and once for each of its descendants
      */
     Signal DescendantAdded;
 
     /**
      * @event DescendantRemoving
      * @param descendant Instance
-     * @description Fires when a descendant is about to be removed
+     * @description Fires when a descendant is about to be removed, once for
+     * the removed instance and once for each of its descendants, while
+     * they are still in the tree
      */
     Signal DescendantRemoving;
 
+    /**
+     * @property DescendantListenersInScope
+     * @internal
+     * @type number
+     * @description DescendantListeners summed over this instance and all of
+     * its ancestors. When zero, adding or removing this instance notifies
+     * nobody and the ancestor walk is skipped.
+     */
+    uint32_t DescendantListenersInScope = 0;
+
     /**
      * @event Destroying
      * @description Fires when this instance is being destroyed
@@ -112,12 +295,29 @@ struct Instance : public Object {
     Instance(const std::string &className = "Instance");
     virtual ~Instance();
 
+    /**
+     * @method Clone
+     * @returns Instance | nil
+     * @description Returns a deep copy of this instance and its descendants
+     * with no parent. Properties, attributes and tags are copied; event
+     * connections are not. Descendants with Archivable set to false are
+     * skipped along with their subtrees, and nil is returned if this
+     * instance is not Archivable.
+     *
+     * @example
+     * ```lua
+     * local copy = prefab:Clone()
+     * copy.Parent = workspace
+     * ```
+     */
+    Instance *Clone() const;
+
     /**
      * @method AddTag
      * @param tag string
      * @description Adds a tag to this instance
      */
-    void AddTag(std::string &tag);
+    void AddTag(const std::string &tag);
 
     /**
      * @method HasTag
@@ -125,14 +325,30 @@ struct Instance : public Object {
      * @returns bool
      * @description Checks if this instance has a specific tag
      */
-    bool HasTag(std::string &tag);
+    bool HasTag(const std::string &tag) const;
 
     /**
      * @method RemoveTag
      * @param tag string
      * @description Removes a tag from this instance
      */
-    void RemoveTag(std::string &tag);
+    void RemoveTag(const std::string &tag);
+
+    /**
+     * @method GetTags
+     * @returns table
+     * @description Returns the tags on this instance, in the order added
+     */
+    std::vector<std::string> GetTags() const;
+
+    /**
+     * @method IsInDataModel
+     * @returns bool
+     * @internal
+     * @description Checks whether this instance is the game or one of its
+     * descendants
+     */
+    bool IsInDataModel() const;
 
     /**
      * @method GetAttribute
@@ -140,20 +356,21 @@ struct Instance : public Object {
      * @returns Attribute | nil
      * @description Gets the value of an attribute
      */
-    std::optional<Attribute> GetAttribute(std::string &attribute);
+    const AttributeValue *GetAttribute(const std::string &attribute) const;
 
     /**
      * @method GetAttributes
      * @returns table
      * @description Returns a table of all attributes
      */
-    std::vector<Attribute> GetAttributes();
+    const std::vector<Attribute> &GetAttributes() const;
 
     /**
      * @method SetAttribute
      * @param attribute string
      * @param value Attribute
-     * @description Sets the value of an attribute
+     * @description Sets the value of an attribute. Setting it to nil from
+     * Lua removes it. Change signals only fire when the value differs.
      *
      * @example
      * ```lua
@@ -161,7 +378,31 @@ struct Instance : public Object {
      * local health = part:GetAttribute("Health")
      * ```
      */
-    void SetAttribute(std::string &attribute, Attribute value);
+    void SetAttribute(const std::string &attribute, AttributeValue value);
+
+    /**
+     * @method RemoveAttribute
+     * @param attribute string
+     * @internal
+     * @description Removes an attribute, firing change signals if it existed
+     */
+    void RemoveAttribute(const std::string &attribute);
+
+    /**
+     * @method GetAttributeChangedSignal
+     * @param attribute string
+     * @returns Signal
+     * @description Returns a signal that fires only when the named attribute
+     * changes
+     *
+     * @example
+     * ```lua
+     * part:GetAttributeChangedSignal("Health"):Connect(function()
+     *     print("Health is now", part:GetAttribute("Health"))
+     * end)
+     * ```
+     */
+    Signal *GetAttributeChangedSignal(const std::string &attribute);
 
     /**
      * @method FindFirstAncestor
@@ -195,6 +436,35 @@ struct Instance : public Object {
      */
     std::optional<Instance *> FindFirstChild(std::string &name);
 
+    /**
+     * @method WaitForChild
+     * @param name string
+     * @param timeout number?
+     * @returns Instance | nil
+     * @yields
+     * @description Returns the first child with the given name, yielding
+     * until one is added or renamed to it if none exists yet. The waiting
+     * task is parked and only resumed when such a child appears, so waiting
+     * costs nothing per frame. Returns nil if timeout seconds pass first,
+     * or if this instance is destroyed while waiting.
+     *
+     * @example
+     * ```lua
+     * local door = workspace:WaitForChild("Door")
+     * local key = door:WaitForChild("Key", 5)
+     * ```
+     */
+    int WaitForChild(lua_State *L);
+
+    /**
+     * @method AddChildWaiter
+     * @internal
+     * @description Registers a task parked by WaitForChild, to be woken when
+     * a child named name appears
+     */
+    void AddChildWaiter(const InternedString &name, lua_State *thread,
+                        uint64_t parkId);
+
     /**
      * @method FindFirstChildOfClass
      * @param name string
@@ -215,7 +485,8 @@ struct Instance : public Object {
      * @method FindFirstDescendant
      * @param name string
      * @returns Instance | nil
-     * @description Finds the first descendant with the specified name
+     * @description Finds the first descendant with the specified name,
+     * searching depth-first in child order
      */
     std::optional<Instance *> FindFirstDescendant(std::string &name);
 
@@ -236,10 +507,79 @@ struct Instance : public Object {
     /**
      * @method GetDescendants
      * @returns table
-     * @description Returns an array of all descendants
+     * @description Returns an array of all descendants in depth-first order
      */
     std::vector<Instance *> GetDescendants();
 
+    /**
+     * @method IterChildren
+     * @returns function
+     * @description Returns an iterator over the direct children for use in a
+     * generic for loop. Walks the child list in place instead of building an
+     * array. Children may be added or removed during the loop: children
+     * added later in the list are visited, removed ones are skipped.
+     *
+     * @example
+     * ```lua
+     * for child in workspace:IterChildren() do
+     *     print(child.Name)
+     * end
+     * ```
+     */
+    InstanceCursor IterChildren();
+
+    /**
+     * @method IterDescendants
+     * @returns function
+     * @description Returns an iterator over all descendants in depth-first
+     * order, walking the tree in place. Instances added after the current
+     * position are visited, instances added before it are not, and removing
+     * any instance (including the current one) is safe.
+     *
+     * @example
+     * ```lua
+     * for descendant in workspace:IterDescendants() do
+     *     if descendant:IsA("BasePart") then
+     *         descendant.Anchored = true
+     *     end
+     * end
+     * ```
+     */
+    InstanceCursor IterDescendants();
+
+    /**
+     * @method QueryDescendants
+     * @param selector string
+     * @returns table
+     * @description Returns the descendants matching selector, in
+     * depth-first order. A selector is a class name (or *) followed by
+     * #Name, .Tag, [$Attribute] and [$Attribute = value] filters;
+     * comma-separated selectors match any of them. The matches are cached
+     * until something in the subtree changes, so repeating a query on an
+     * unchanged subtree does not walk it again. Only the matching is
+     * cached: each call still returns a new table, so a repeated query
+     * costs one push per result.
+     *
+     * @example
+     * ```lua
+     * for _, enemy in workspace:QueryDescendants("Part.Enemy[$Health]") do
+     *     enemy:SetAttribute("Health", 0)
+     * end
+     * ```
+     */
+    const std::vector<Instance *> &
+    QueryDescendants(const std::shared_ptr<const InstanceQuery> &query);
+
+    /**
+     * @method GetNextDescendant
+     * @param current Instance
+     * @returns Instance | nil
+     * @internal
+     * @description Returns the descendant visited after current in a
+     * depth-first walk of this instance, or nil when the walk is done
+     */
+    Instance *GetNextDescendant(Instance *current) const;
+
     /**
      * @method IsAncestorOf
      * @param descendant Instance
@@ -258,16 +598,86 @@ struct Instance : public Object {
 
     /**
      * @method ClearAllChildren
-     * @description Removes and destroys all children
+     * @description Removes and destroys all children, except services
      */
     void ClearAllChildren();
 
     /**
      * @method Destroy
-     * @description Permanently destroys this instance and all descendants
+     * @description Permanently destroys this instance and all descendants.
+     * Parent is set to nil and locked. Memory is released at the next
+     * scheduler step; Lua references used after that raise an
+     * "instance destroyed" error. Calling Destroy again does nothing.
+     * Services and the DataModel cannot be destroyed.
      */
     void Destroy();
 
+    /**
+     * @method CanDestroy
+     * @internal
+     * @returns bool
+     * @description False for services and the DataModel. The engine keeps
+     * pointers to them, so they are never destroyed and, once parented,
+     * their Parent is locked.
+     */
+    virtual bool CanDestroy() const { return true; }
+
+    /**
+     * @method IsParentLocked
+     * @internal
+     * @returns bool
+     * @description Whether Parent can no longer change: the instance is
+     * destroyed, or it is a service that already has a parent
+     */
+    bool IsParentLocked() const {
+        return Destroyed || (Parent && !CanDestroy());
+    }
+
+    /**
+     * @method FreeDestroyed
+     * @internal
+     * @returns number
+     * @description Deletes every instance destroyed since the last call.
+     * Called once per scheduler step, outside of any script, so no running
+     * C++ frame can still hold one of them.
+     */
+    static size_t FreeDestroyed();
+
+    /**
+     * @method DestroyAll
+     * @internal
+     * @description Destroys every live instance, services and the DataModel
+     * included, for shutdown. Run it while Lua is still open so Destroying
+     * handlers can run, then FreeDestroyed until it returns 0.
+     */
+    static void DestroyAll();
+
+    /**
+     * @method GetLiveCount
+     * @internal
+     * @returns number
+     * @description Number of Instance objects currently allocated,
+     * including destroyed ones that have not been freed yet
+     */
+    static size_t GetLiveCount();
+
+    /**
+     * @method UpdateDescendantListenerCount
+     * @internal
+     * @description Recounts connections on DescendantAdded and
+     * DescendantRemoving. Both signals call it whenever their connections
+     * change.
+     */
+    void UpdateDescendantListenerCount();
+
+    /**
+     * @method SetName
+     * @param name string
+     * @description Renames this instance, keeping the parent's name index
+     * up to date
+     */
+    void SetName(const std::string &name);
+
     /**
      * @method SetParent
      * @param newParent Instance | nil
@@ -275,6 +685,111 @@ struct Instance : public Object {
      */
     void SetParent(Instance *newParent);
 
+    /**
+     * @method BulkSetParent
+     * @param instances table
+     * @param newParent Instance | nil
+     * @description Reparents every instance in the list. DescendantRemoving
+     * fires first for every instance, then all hierarchy changes are
+     * applied; ChildAdded, DescendantAdded, AncestryChanged and ChildRemoved
+     * then fire in one pass, in list order. Instances already
+     * under newParent, that would become their own ancestor, or that have
+     * been destroyed are skipped, and an instance listed more than once is
+     * moved once.
+     *
+     * @example
+     * ```lua
+     * Instance.BulkSetParent(parts, workspace)
+     * ```
+     */
+    static void BulkSetParent(const std::vector<Instance *> &instances,
+                              Instance *newParent);
+
+    /**
+     * @method BulkDestroy
+     * @param instances table
+     * @description Destroys every instance in the list. DescendantRemoving
+     * fires first for every instance, then all instances are detached from
+     * their parents, then Destroying and ChildRemoved
+     * fire in one pass, in list order. Parent is already nil when Destroying
+     * fires. An instance listed more than once is destroyed once.
+     */
+    static void BulkDestroy(const std::vector<Instance *> &instances);
+
+    /**
+     * @method SetProperties
+     * @param properties table
+     * @description Sets every property in a name → value table in one
+     * call. Each name is resolved once, then the values are written in a
+     * native loop without going through __newindex. Properties are applied
+     * in table iteration order, so set Parent separately if it must come
+     * last.
+     *
+     * @example
+     * ```lua
+     * part:SetProperties({
+     *     Position = Vector3.new(0, 10, 0),
+     *     Color = Color3.new(1, 0, 0),
+     *     Anchored = true,
+     * })
+     * ```
+     */
+    void SetProperties(lua_State *L, int propertiesIdx);
+
+    /**
+     * @method GetProperties
+     * @param names table
+     * @returns table
+     * @description Reads every property named in the array and returns a
+     * name → value table, suitable for passing back to SetProperties
+     *
+     * @example
+     * ```lua
+     * local saved = part:GetProperties({"Position", "Color"})
+     * other:SetProperties(saved)
+     * ```
+     */
+    void GetProperties(lua_State *L, int namesIdx);
+
+    /**
+     * @method BulkSetProperties
+     * @param instances table
+     * @param properties table
+     * @description Sets properties on many instances in one call.
+     * properties maps each property name to an array of values parallel to
+     * instances: instances[i] gets values[i]. Each name is resolved once per
+     * class in the list.
+     *
+     * @example
+     * ```lua
+     * Instance.BulkSetProperties(parts, {
+     *     Position = positions,
+     *     Transparency = transparencies,
+     * })
+     * ```
+     */
+    static void BulkSetProperties(lua_State *L, int instancesIdx,
+                                  int propertiesIdx);
+
+    /**
+     * @method GetPropertyInfo
+     * @param className string
+     * @returns table
+     * @description Lists every property of a class, inherited ones
+     * included, sorted by name. Each entry has Name, Class (the class that
+     * binds it) and ReadOnly. Properties stored directly in a data member
+     * also have Type, the member's C++ type, and Default, its value in a
+     * new instance when the class can be created.
+     *
+     * @example
+     * ```lua
+     * for _, info in Instance.GetPropertyInfo("Part") do
+     *     print(info.Name, info.Type, info.Default)
+     * end
+     * ```
+     */
+    static void GetPropertyInfo(lua_State *L, const std::string &className);
+
     /**
      * @method AddChild
      * @param child Instance
@@ -289,7 +804,54 @@ struct Instance : public Object {
      */
     void RemoveChild(Instance *child);
 
-    virtual bool IsA(const std::string &className) const;
+    /**
+     * @method As
+     * @returns T | nil
+     * @internal
+     * @description Checked downcast: returns this as T when this instance
+     * is a T (by class id), otherwise nullptr
+     */
+    template <typename T> T *As() {
+        static const ClassId classId =
+            ClassRegistry::GetClassId(T::StaticClassName);
+        return IsA(classId) ? static_cast<T *>(this) : nullptr;
+    }
+
+    template <typename T> const T *As() const {
+        return const_cast<Instance *>(this)->As<T>();
+    }
+
+protected:
+    // Copies Object fields, Archivable, attributes and tags, but not the
+    // hierarchy, name index or event connections
+    Instance(const Instance &other);
+
+    // Copy of this instance alone, used by Clone. Classes that must not be
+    // cloned (services) return nullptr.
+    virtual Instance *CloneInstance() const;
+
+private:
+    Instance *FindChildByName(const InternedString &name) const;
+    void Relink(Instance *newParent);
+    void SyncTagIndex();
+    void FireAttributeChanged(const InternedString &attribute);
+    void AdjustTaggedSubtreeCount(int64_t delta);
+    void FireParentChanged(Instance *oldParent);
+    void LinkChild(Instance *child);
+    void UnlinkChild(Instance *child);
+    void IndexChildName(Instance *child);
+    void UnindexChildName(Instance *child);
+    void QueueFree();
+    void DestroyTree();
+    void MarkSubtreeModified();
+    void AdjustDescendantListenerScope(int64_t delta);
+    void FireDescendantAdded();
+    void FireDescendantRemoving();
+    void WakeChildWaiters(Instance *child);
+    void RemoveChildWaiter(uint64_t parkId);
+    void DropQueryCache();
+    void HookDescendantSignals();
+    InstanceExtras &GetExtras();
 };
 
 void Class_Instance_Bind(lua_State *L);
\ No newline at end of file
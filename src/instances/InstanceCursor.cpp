@@ -0,0 +1,124 @@
+#include "InstanceCursor.h"
+#include "../core/LuaClassBinder.h"
+#include "Instance.h"
+#include <new>
+
+InstanceCursor::InstanceCursor(Instance *root, bool recursive)
+    : Root(root), Current(root), Recursive(recursive) {
+    NextActive = ActiveHead;
+    if (ActiveHead)
+        ActiveHead->PrevActive = this;
+    ActiveHead = this;
+}
+
+InstanceCursor::~InstanceCursor() { Finish(); }
+
+void InstanceCursor::Finish() {
+    if (!Root)
+        return;
+
+    if (PrevActive)
+        PrevActive->NextActive = NextActive;
+    else
+        ActiveHead = NextActive;
+    if (NextActive)
+        NextActive->PrevActive = PrevActive;
+
+    PrevActive = nullptr;
+    NextActive = nullptr;
+    Root = nullptr;
+    Current = nullptr;
+}
+
+Instance *InstanceCursor::Next() {
+    if (!Root)
+        return nullptr;
+
+    Instance *next = nullptr;
+    if (Current == Root) {
+        next = Root->FirstChild;
+    } else if (!Recursive) {
+        next = Current->NextSibling;
+    } else if (!SkipSubtree && Current->FirstChild) {
+        next = Current->FirstChild;
+    } else {
+        // Climb until some ancestor below the root has a next sibling
+        for (Instance *node = Current; node != Root; node = node->Parent) {
+            if (node->NextSibling) {
+                next = node->NextSibling;
+                break;
+            }
+        }
+    }
+
+    SkipSubtree = false;
+    if (!next) {
+        Finish();
+        return nullptr;
+    }
+
+    Current = next;
+    return next;
+}
+
+void InstanceCursor::OnUnlink(Instance *child) {
+    for (InstanceCursor *cursor = ActiveHead; cursor;
+         cursor = cursor->NextActive) {
+        // Moving the root itself leaves its subtree intact
+        if (child == cursor->Root)
+            continue;
+
+        // Only matters when the walk position is inside the removed subtree
+        Instance *node = cursor->Current;
+        while (node && node != cursor->Root && node != child)
+            node = node->Parent;
+        if (node != child)
+            continue;
+
+        // Step back to the position just before child in depth-first order
+        if (child->PrevSibling) {
+            cursor->Current = child->PrevSibling;
+            cursor->SkipSubtree = true;
+        } else {
+            cursor->Current = child->Parent;
+            cursor->SkipSubtree = false;
+        }
+    }
+}
+
+void InstanceCursor::OnDestroy(Instance *root) {
+    InstanceCursor *cursor = ActiveHead;
+    while (cursor) {
+        InstanceCursor *next = cursor->NextActive;
+        if (cursor->Root == root)
+            cursor->Finish();
+        cursor = next;
+    }
+}
+
+static void CursorDtor(void *ud) {
+    static_cast<InstanceCursor *>(ud)->~InstanceCursor();
+}
+
+static int CursorNext(lua_State *L) {
+    auto *cursor =
+        static_cast<InstanceCursor *>(lua_touserdata(L, lua_upvalueindex(1)));
+    // Raises if the root was freed since the loop started
+    LuaClassBinder::CheckInstance(L, lua_upvalueindex(2));
+
+    Instance *next = cursor->Next();
+    if (next)
+        LuaClassBinder::PushInstance(L, next);
+    else
+        lua_pushnil(L);
+    return 1;
+}
+
+void InstanceCursor::Push(lua_State *L, Instance *root, bool recursive) {
+    void *ud = lua_newuserdatadtor(L, sizeof(InstanceCursor), CursorDtor);
+    new (ud) InstanceCursor(root, recursive);
+    // Root handle, checked on every step
+    LuaClassBinder::PushInstance(L, root);
+    lua_pushcclosure(L, CursorNext,
+                     recursive ? "IterDescendants" : "IterChildren", 2);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+struct Instance;
+struct lua_State;
+
+// In-place walk over the children or descendants of an instance. Backs
+// Instance:IterChildren and Instance:IterDescendants; only the last returned
+// instance is remembered, so no copy of the tree is built.
+//
+// The tree may change while a walk is in progress:
+//  - Instances inserted after the cursor in depth-first order are visited,
+//    instances inserted before it are not.
+//  - Removing any instance, including the one just returned, is safe. The
+//    walk resumes where the removed subtree used to be.
+//  - An instance moved to a later position under the root is visited again.
+//  - Destroying or clearing the root ends the walk.
+//
+// Live cursors are kept in a list so Instance can fix them up when a child is
+// unlinked; while no cursor is live that check is a single pointer test.
+// Destroying the root takes its cursors off the list, so the list never
+// points at a freed instance, or at another one recycled into its memory.
+struct InstanceCursor {
+    Instance *Root = nullptr;
+
+    // Last instance returned, or Root before the first step
+    Instance *Current = nullptr;
+
+    // Set when Current's subtree has already been walked
+    bool SkipSubtree = false;
+
+    bool Recursive = false;
+
+    InstanceCursor *PrevActive = nullptr;
+    InstanceCursor *NextActive = nullptr;
+
+    static inline InstanceCursor *ActiveHead = nullptr;
+
+    InstanceCursor(Instance *root, bool recursive);
+    ~InstanceCursor();
+
+    InstanceCursor(const InstanceCursor &) = delete;
+    InstanceCursor &operator=(const InstanceCursor &) = delete;
+
+    // Advance and return the next instance, or nullptr once the walk is done
+    Instance *Next();
+
+    // Called by Instance before child is unlinked from its parent
+    static void OnUnlink(Instance *child);
+
+    // Called by Instance when root is destroyed; ends every walk over it
+    static void OnDestroy(Instance *root);
+
+    // Push a Lua iterator function that owns a new cursor
+    static void Push(lua_State *L, Instance *root, bool recursive);
+
+private:
+    void Finish();
+};
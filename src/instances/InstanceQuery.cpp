@@ -0,0 +1,278 @@
+#include "InstanceQuery.h"
+#include "Instance.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+
+bool ValueMatches(const AttributeValue &actual,
+                  const InstanceQuery::Value &expected) {
+    if (auto *b = std::get_if<bool>(&expected)) {
+        auto *a = std::get_if<bool>(&actual);
+        return a && *a == *b;
+    }
+    if (auto *d = std::get_if<double>(&expected)) {
+        auto *a = std::get_if<double>(&actual);
+        return a && *a == *d;
+    }
+    auto *a = std::get_if<std::string>(&actual);
+    return a && *a == std::get<std::string>(expected);
+}
+
+bool AlternativeMatches(const InstanceQuery::Alternative &alt,
+                        const Instance *inst) {
+    if (alt.Class != kInvalidClassId && !inst->IsA(alt.Class))
+        return false;
+
+    for (const InternedString &name : alt.Names)
+        if (inst->Name != name)
+            return false;
+
+    for (const InternedString &tag : alt.Tags)
+        if (std::find(inst->Tags.begin(), inst->Tags.end(), tag) ==
+            inst->Tags.end())
+            return false;
+
+    for (const auto &filter : alt.Attributes) {
+        const AttributeValue *value = nullptr;
+        for (const Attribute &attr : inst->Attributes) {
+            if (attr.Name == filter.Name) {
+                value = &attr.Value;
+                break;
+            }
+        }
+        if (!value)
+            return false;
+        if (filter.HasValue && !ValueMatches(*value, filter.Expected))
+            return false;
+    }
+
+    return true;
+}
+
+// Recursive-descent parser over the selector text
+struct SelectorParser {
+    const std::string &text;
+    size_t pos = 0;
+    std::string &error;
+
+    bool AtEnd() const { return pos >= text.size(); }
+    char Peek() const { return AtEnd() ? '\0' : text[pos]; }
+
+    void SkipSpaces() {
+        while (!AtEnd() && std::isspace((unsigned char)text[pos]))
+            ++pos;
+    }
+
+    bool Fail(const std::string &message) {
+        error = message + " at position " + std::to_string(pos + 1) +
+                " in selector '" + text + "'";
+        return false;
+    }
+
+    static bool IsWordChar(char c) {
+        return std::isalnum((unsigned char)c) || c == '_';
+    }
+
+    bool ParseWord(std::string &out) {
+        size_t start = pos;
+        while (!AtEnd() && IsWordChar(text[pos]))
+            ++pos;
+        if (pos == start)
+            return Fail("expected a name");
+        out = text.substr(start, pos - start);
+        return true;
+    }
+
+    bool ParseQuoted(std::string &out) {
+        char quote = text[pos++];
+        size_t start = pos;
+        while (!AtEnd() && text[pos] != quote)
+            ++pos;
+        if (AtEnd())
+            return Fail("unterminated string");
+        out = text.substr(start, pos - start);
+        ++pos;
+        return true;
+    }
+
+    // Bare word or quoted string
+    bool ParseText(std::string &out) {
+        if (Peek() == '"' || Peek() == '\'')
+            return ParseQuoted(out);
+        return ParseWord(out);
+    }
+
+    bool ParseValue(InstanceQuery::Value &out) {
+        if (Peek() == '"' || Peek() == '\'') {
+            std::string s;
+            if (!ParseQuoted(s))
+                return false;
+            out = std::move(s);
+            return true;
+        }
+
+        size_t start = pos;
+        while (!AtEnd() && (IsWordChar(text[pos]) || text[pos] == '.' ||
+                            text[pos] == '-' || text[pos] == '+'))
+            ++pos;
+        if (pos == start)
+            return Fail("expected a value");
+
+        std::string word = text.substr(start, pos - start);
+        if (word == "true") {
+            out = true;
+        } else if (word == "false") {
+            out = false;
+        } else {
+            char *end = nullptr;
+            double number = std::strtod(word.c_str(), &end);
+            if (end && *end == '\0')
+                out = number;
+            else
+                out = std::move(word);
+        }
+        return true;
+    }
+
+    bool ParseAttribute(InstanceQuery::Alternative &alt) {
+        ++pos; // '['
+        SkipSpaces();
+        if (Peek() != '$')
+            return Fail("expected '$' before attribute name");
+        ++pos;
+
+        InstanceQuery::AttributeFilter filter;
+        std::string name;
+        if (!ParseText(name))
+            return false;
+        filter.Name = InternedString(name);
+
+        SkipSpaces();
+        if (Peek() == '=') {
+            ++pos;
+            SkipSpaces();
+            if (!ParseValue(filter.Expected))
+                return false;
+            filter.HasValue = true;
+            SkipSpaces();
+        }
+
+        if (Peek() != ']')
+            return Fail("expected ']'");
+        ++pos;
+
+        alt.Attributes.push_back(std::move(filter));
+        return true;
+    }
+
+    bool ParseAlternative(InstanceQuery::Alternative &alt) {
+        SkipSpaces();
+
+        bool any = false;
+        if (Peek() == '*') {
+            ++pos;
+            any = true;
+        } else if (IsWordChar(Peek())) {
+            std::string className;
+            ParseWord(className);
+            alt.Class = ClassRegistry::FindClassId(className);
+            if (alt.Class == kInvalidClassId)
+                return Fail("unknown class '" + className + "'");
+            any = true;
+        }
+
+        for (;;) {
+            char c = Peek();
+            std::string word;
+            if (c == '#') {
+                ++pos;
+                if (!ParseText(word))
+                    return false;
+                alt.Names.emplace_back(word);
+            } else if (c == '.') {
+                ++pos;
+                if (!ParseText(word))
+                    return false;
+                alt.Tags.emplace_back(word);
+            } else if (c == '[') {
+                if (!ParseAttribute(alt))
+                    return false;
+            } else {
+                break;
+            }
+            any = true;
+        }
+
+        if (!any)
+            return Fail("expected a class, '*', '#', '.' or '['");
+
+        SkipSpaces();
+        return true;
+    }
+
+    bool Parse(InstanceQuery &query) {
+        for (;;) {
+            InstanceQuery::Alternative alt;
+            if (!ParseAlternative(alt))
+                return false;
+            query.Alternatives.push_back(std::move(alt));
+
+            if (AtEnd())
+                return true;
+            if (Peek() != ',')
+                return Fail("unexpected '" + std::string(1, Peek()) + "'");
+            ++pos;
+        }
+    }
+};
+
+} // namespace
+
+bool InstanceQuery::Matches(const Instance *inst) const {
+    for (const Alternative &alt : Alternatives)
+        if (AlternativeMatches(alt, inst))
+            return true;
+    return false;
+}
+
+// Live compilations by source text. Leaked, like the InternedString table,
+// so queries released during static teardown can still unlist themselves.
+static std::unordered_map<std::string, std::weak_ptr<const InstanceQuery>> &
+CompiledQueries() {
+    static auto *compiled =
+        new std::unordered_map<std::string,
+                               std::weak_ptr<const InstanceQuery>>();
+    return *compiled;
+}
+
+InstanceQuery::Ptr InstanceQuery::Compile(const std::string &selector,
+                                          std::string &error) {
+    auto &compiled = CompiledQueries();
+    auto it = compiled.find(selector);
+    if (it != compiled.end())
+        if (Ptr live = it->second.lock())
+            return live;
+
+    auto query = std::make_unique<InstanceQuery>();
+    query->Source = selector;
+
+    SelectorParser parser{selector, 0, error};
+    if (!parser.Parse(*query))
+        return nullptr;
+
+    // The last holder removes the entry along with the query
+    Ptr shared(query.release(), [](const InstanceQuery *released) {
+        auto &queries = CompiledQueries();
+        auto entry = queries.find(released->Source);
+        if (entry != queries.end() && entry->second.expired())
+            queries.erase(entry);
+        delete released;
+    });
+    compiled[selector] = shared;
+    return shared;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "../core/ClassRegistry.h"
+#include "../core/InternedString.h"
+
+struct Instance;
+
+// Compiled selector behind Instance:QueryDescendants. A selector is one or
+// more comma-separated alternatives; an instance matches when it matches
+// any of them. Each alternative is an optional class name followed by any
+// number of filters, all of which must hold:
+//
+//   Part                 IsA("Part")
+//   *                    any class
+//   #Name  #"Two Words"  Name equals
+//   .Tag   ."Two Words"  HasTag
+//   [$Attr]              attribute is set
+//   [$Attr = value]      attribute equals value (number, true, false, or a
+//                        bare or quoted string)
+//
+// e.g. "Part.Enemy[$Health = 100], Model#Boss"
+//
+// Compiled selectors are shared by source text while anything holds them.
+// Per-instance result caches own theirs, so the pointer doubles as the
+// cache key, and a selector nothing caches any more is freed.
+struct InstanceQuery {
+    using Value = std::variant<bool, double, std::string>;
+    using Ptr = std::shared_ptr<const InstanceQuery>;
+
+    struct AttributeFilter {
+        InternedString Name;
+        bool HasValue = false;
+        Value Expected;
+    };
+
+    struct Alternative {
+        ClassId Class = kInvalidClassId; // kInvalidClassId matches any class
+        std::vector<InternedString> Names;
+        std::vector<InternedString> Tags;
+        std::vector<AttributeFilter> Attributes;
+    };
+
+    std::string Source;
+    std::vector<Alternative> Alternatives;
+
+    bool Matches(const Instance *inst) const;
+
+    // Compile selector, or return the live compilation of the same text.
+    // Returns nullptr and fills error when the selector is malformed.
+    static Ptr Compile(const std::string &selector, std::string &error);
+};
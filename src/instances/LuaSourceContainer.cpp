@@ -6,9 +6,10 @@
 #include <sstream>
 
 LuaSourceContainer::LuaSourceContainer(const std::string &className)
-    : Instance(className) {
-    ClassName = className;
-    Name = className;
+    : Instance(className) {}
+
+Instance *LuaSourceContainer::CloneInstance() const {
+    return new LuaSourceContainer(*this);
 }
 
 bool LuaSourceContainer::LoadFromPath() {
@@ -54,54 +55,12 @@ bool LuaSourceContainer::Execute(lua_State *L) {
     return Task_RunScript(L, scriptSource);
 }
 
-bool LuaSourceContainer::IsA(const std::string &className) const {
-    return this->ClassName == className || Instance::IsA(className);
-}
-
 void LuaSourceContainer_Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("LuaSourceContainer", "Instance");
 
-    // Enabled property
-    LuaClassBinder::AddProperty(
-        "LuaSourceContainer", "Enabled",
-        [](lua_State *L, Instance *inst) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            lua_pushboolean(L, container->Enabled);
-            return 1;
-        },
-        [](lua_State *L, Instance *inst, int valueIdx) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            container->Enabled = lua_toboolean(L, valueIdx) != 0;
-            return 0;
-        });
-
-    // Source property
-    LuaClassBinder::AddProperty(
-        "LuaSourceContainer", "Source",
-        [](lua_State *L, Instance *inst) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            lua_pushstring(L, container->Source.c_str());
-            return 1;
-        },
-        [](lua_State *L, Instance *inst, int valueIdx) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            container->Source = luaL_checkstring(L, valueIdx);
-            return 0;
-        });
-
-    // SourcePath property
-    LuaClassBinder::AddProperty(
-        "LuaSourceContainer", "SourcePath",
-        [](lua_State *L, Instance *inst) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            lua_pushstring(L, container->SourcePath.c_str());
-            return 1;
-        },
-        [](lua_State *L, Instance *inst, int valueIdx) -> int {
-            auto *container = static_cast<LuaSourceContainer *>(inst);
-            container->SourcePath = luaL_checkstring(L, valueIdx);
-            return 0;
-        });
+    LuaClassBinder::AddField<&LuaSourceContainer::Enabled>("Enabled");
+    LuaClassBinder::AddField<&LuaSourceContainer::Source>("Source");
+    LuaClassBinder::AddField<&LuaSourceContainer::SourcePath>("SourcePath");
 
     // Execute method
     LuaClassBinder::AddMethod("LuaSourceContainer", "Execute",
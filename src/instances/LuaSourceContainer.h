@@ -27,8 +27,9 @@
  *
  */
 struct LuaSourceContainer : public Instance {
+    static constexpr const char *StaticClassName = "LuaSourceContainer";
+
     //-- Properties --//
-    std::string Name = ClassName;
 
     /**
      * @property Enabled
@@ -63,7 +64,8 @@ struct LuaSourceContainer : public Instance {
     bool Execute(lua_State *L);
     bool LoadFromPath();
 
-    virtual bool IsA(const std::string &className) const;
+protected:
+    Instance *CloneInstance() const override;
 };
 
 // Binding
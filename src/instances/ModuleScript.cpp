@@ -9,6 +9,13 @@ ModuleScript::ModuleScript() : LuaSourceContainer("ModuleScript") {
     Name = "ModuleScript";
 }
 
+ModuleScript::ModuleScript(const ModuleScript &other)
+    : LuaSourceContainer(other) {}
+
+Instance *ModuleScript::CloneInstance() const {
+    return new ModuleScript(*this);
+}
+
 ModuleScript::~ModuleScript() {
     // Clean up the module reference if it exists
     if (ModuleRef != LUA_NOREF && LuaSourceContainer::Enabled) {
@@ -49,8 +56,12 @@ int ModuleScript::Require(lua_State *L) {
 
     // Compile the script
     size_t bytecodeSize = 0;
+    lua_CompileOptions opts{};
+    opts.optimizationLevel = 1;
+    opts.debugLevel = 1;
+    Vector3Game_ConfigureCompiler(opts);
     char *bytecode = luau_compile(scriptSource.c_str(), scriptSource.size(),
-                                  nullptr, &bytecodeSize);
+                                  &opts, &bytecodeSize);
 
     if (!bytecode) {
         luaL_error(L, "Failed to compile ModuleScript '%s'", Name.c_str());
@@ -58,7 +69,7 @@ int ModuleScript::Require(lua_State *L) {
     }
 
     // Load the bytecode
-    std::string chunkname = "@" + Name;
+    std::string chunkname = "@" + Name.str();
     // Prepare per-module environment and pass it to luau_load
     lua_newtable(L);              // env
     lua_newtable(L);              // mt
@@ -95,10 +106,6 @@ int ModuleScript::Require(lua_State *L) {
     return 1;
 }
 
-bool ModuleScript::IsA(const std::string &className) const {
-    return this->ClassName == className || LuaSourceContainer::IsA(className);
-}
-
 void ModuleScript_Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("ModuleScript", "LuaSourceContainer");
 
@@ -128,13 +135,13 @@ void ModuleScript_Bind(lua_State *L) {
             }
 
             Instance *inst = LuaClassBinder::CheckInstance(L, 1);
-            if (!inst->IsA("ModuleScript")) {
+            ModuleScript *module = inst->As<ModuleScript>();
+            if (!module) {
                 luaL_error(L, "require expects a ModuleScript, got %s",
                            inst->ClassName.c_str());
                 return 0;
             }
 
-            ModuleScript *module = static_cast<ModuleScript *>(inst);
             return module->Require(L);
         },
         "require");
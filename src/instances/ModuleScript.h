@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core/ObjectPool.h"
 #include "LuaSourceContainer.h"
 
 /**
@@ -26,7 +27,10 @@
  * print(myModule.greet("World"))
  * ```
  */
-struct ModuleScript : public LuaSourceContainer {
+struct ModuleScript : public LuaSourceContainer,
+                      public Pooled<ModuleScript> {
+    static constexpr const char *StaticClassName = "ModuleScript";
+
     //-- Properties --//
 
     /**
@@ -62,7 +66,10 @@ struct ModuleScript : public LuaSourceContainer {
      */
     int Require(lua_State *L);
 
-    virtual bool IsA(const std::string &className) const override;
+protected:
+    // The copy starts unloaded and requires its own module value
+    ModuleScript(const ModuleScript &other);
+    Instance *CloneInstance() const override;
 };
 
 void ModuleScript_Bind(lua_State *L);
\ No newline at end of file
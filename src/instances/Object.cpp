@@ -3,14 +3,16 @@
 
 // Constructor
 Object::Object(const std::string &className)
-    : ClassName(className), Name(className) {}
+    : ClassName(className), ClassIndex(ClassRegistry::GetClassId(className)),
+      Name(className) {}
 
 // Destructor
 Object::~Object() {}
 
 // IsA implementation
 bool Object::IsA(const std::string &className) const {
-    return this->ClassName == className || className == "Object";
+    ClassId classId = ClassRegistry::FindClassId(className);
+    return classId != kInvalidClassId && IsA(classId);
 }
 
 // FirePropertyChanged implementation
@@ -28,7 +30,7 @@ void Object_Bind(lua_State *L) {
         "Object", "ClassName",
         [](lua_State *L, Instance *inst) -> int {
             Object *obj = reinterpret_cast<Object *>(inst);
-            lua_pushstring(L, obj->ClassName.c_str());
+            lua_pushlstring(L, obj->ClassName.c_str(), obj->ClassName.size());
             return 1;
         },
         nullptr);
@@ -38,7 +40,7 @@ void Object_Bind(lua_State *L) {
         "Object", "Name",
         [](lua_State *L, Instance *inst) -> int {
             Object *obj = reinterpret_cast<Object *>(inst);
-            lua_pushstring(L, obj->Name.c_str());
+            lua_pushlstring(L, obj->Name.c_str(), obj->Name.size());
             return 1;
         },
         [](lua_State *L, Instance *inst, int valueIdx) -> int {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../core/ClassRegistry.h"
+#include "../core/InternedString.h"
 #include "../core/Signal.h"
 #include <algorithm>
 #include <functional>
@@ -28,16 +30,26 @@ struct Object {
      * @property ClassName
      * @type string
      * @readonly
-     * @description The name of this object's class
+     * @description The name of this object's class. Interned, so every
+     * instance of a class shares one copy of the string
      */
-    std::string ClassName;
+    InternedString ClassName;
+
+    /**
+     * @property ClassIndex
+     * @internal
+     * @type number
+     * @description Numeric id of ClassName, used for constant-time IsA checks
+     */
+    ClassId ClassIndex;
 
     /**
      * @property Name
      * @type string
-     * @description The name of this object
+     * @description The name of this object. Interned, so instances sharing a
+     * name share one copy of the string and compare by pointer
      */
-    std::string Name;
+    InternedString Name;
 
     //-- Events --//
 
@@ -66,7 +78,11 @@ struct Object {
      * @description Checks if this object is an instance of the specified class
      *
      */
-    virtual bool IsA(const std::string &className) const;
+    bool IsA(const std::string &className) const;
+
+    bool IsA(ClassId classId) const {
+        return ClassRegistry::IsA(ClassIndex, classId);
+    }
 
     /**
      * @method FirePropertyChanged
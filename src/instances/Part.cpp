@@ -9,27 +9,21 @@
 const char *validShapes[] = {"Block", "Sphere",      "Cylinder",
                              "Wedge", "CornerWedge", nullptr};
 
-Part::Part() : BasePart() {
-    ClassName = "Part";
-    Shape = "Block";
-}
+Part::Part() : BasePart("Part") { Shape = "Block"; }
 
 Part::Part(const std::string &name, const Vector3Game &position,
            const Vector3Game &size, const Color3 &color, bool anchored,
            std::string shape)
-    : BasePart() {
+    : BasePart("Part") {
     Name = name;
     Position = position;
     Size = size;
     Color = color;
     Anchored = anchored;
     Shape = shape;
-    ClassName = "Part";
 }
 
-bool Part::IsA(const std::string &className) const {
-    return this->ClassName == className || BasePart::IsA(className);
-}
+Instance *Part::CloneInstance() const { return new Part(*this); }
 
 void Part_Bind(lua_State *L) {
     (void)L; // Suppress unused parameter warning
@@ -123,10 +117,7 @@ void Part_Bind(lua_State *L) {
     // Set constructor
     LuaClassBinder::SetConstructor("Part", []() -> Instance * {
         Part *part = new Part();
-        // Add to global instances if needed
-        if (LuaBindings::g_instances) {
-            LuaBindings::g_instances->push_back(part);
-        }
+        AddToRenderList(part);
         return part;
     });
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <string>
 
+#include "../core/ObjectPool.h"
 #include "BasePart.h"
 
 extern const char *validShapes[];
@@ -27,7 +28,9 @@ extern const char *validShapes[];
  * platform.Parent = workspace
  * ```
  */
-struct Part : public BasePart {
+struct Part : public BasePart, public Pooled<Part> {
+    static constexpr const char *StaticClassName = "Part";
+
     std::string Shape = "Wedge";
 
     Part();
@@ -36,7 +39,9 @@ struct Part : public BasePart {
          const Vector3Game &size, const Color3 &color, bool anchored,
          std::string shape = "Wedge");
 
-    virtual bool IsA(const std::string &className) const;
+protected:
+    Part(const Part &other) = default;
+    Instance *CloneInstance() const override;
 };
 
 void Part_Bind(lua_State *L);
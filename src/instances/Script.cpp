@@ -4,9 +4,7 @@
 
 Script::Script() : LuaSourceContainer("Script") { Name = "Script"; }
 
-bool Script::IsA(const std::string &className) const {
-    return this->ClassName == className || LuaSourceContainer::IsA(className);
-}
+Instance *Script::CloneInstance() const { return new Script(*this); }
 
 void Script_Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("Script", "LuaSourceContainer");
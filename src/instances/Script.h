@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core/ObjectPool.h"
 #include "LuaSourceContainer.h"
 
 /**
@@ -14,7 +15,9 @@
  * @inherits LuaSourceContainer
  *
  */
-struct Script : public LuaSourceContainer {
+struct Script : public LuaSourceContainer, public Pooled<Script> {
+    static constexpr const char *StaticClassName = "Script";
+
     //-- Properties --//
     // RunContext could be added here for Legacy/Client/Server/Plugin
 
@@ -22,7 +25,8 @@ struct Script : public LuaSourceContainer {
     Script();
     virtual ~Script() = default;
 
-    virtual bool IsA(const std::string &className) const override;
+protected:
+    Instance *CloneInstance() const override;
 };
 
 void Script_Bind(lua_State *L);
\ No newline at end of file
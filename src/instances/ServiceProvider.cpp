@@ -37,10 +37,6 @@ void ServiceProvider::RegisterService(const std::string &name,
     Services[name] = service;
 }
 
-bool ServiceProvider::IsA(const std::string &className) const {
-    return className == "ServiceProvider" || Instance::IsA(className);
-}
-
 void ServiceProvider::Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("ServiceProvider", "Instance");
 
@@ -20,6 +20,8 @@
  *
  */
 struct ServiceProvider : public Instance {
+    static constexpr const char *StaticClassName = "ServiceProvider";
+
 protected:
     /**
      * @property Services
@@ -65,7 +67,9 @@ public:
     void RegisterService(const std::string &name, ::Instance *service);
     virtual ::Instance *CreateService(const std::string &serviceName) = 0;
 
-    virtual bool IsA(const std::string &className) const override;
+    // Services are singletons and cannot be cloned
+    ::Instance *CloneInstance() const override { return nullptr; }
+    bool CanDestroy() const override { return false; }
 
     static void Bind(lua_State *L);
 };
\ No newline at end of file
@@ -3,32 +3,107 @@
 #include "BasePart.h"
 #include "DataModel.h"
 #include "Part.h"
+#include "../core/EnumRegistry.h"
 #include <cmath>
+#include <cstring>
 
 Workspace::Workspace() : Instance("Workspace") { Name = "Workspace"; }
 
+void Workspace::BulkMoveTo(const std::vector<BasePart *> &parts,
+                           const Vector3Game *positions,
+                           const Vector3Game *rotations, BulkMoveMode mode) {
+    for (size_t i = 0; i < parts.size(); ++i) {
+        parts[i]->Position = positions[i];
+        if (rotations)
+            parts[i]->Rotation = rotations[i];
+    }
+
+    if (mode == BulkMoveMode::SkipChangedEvents)
+        return;
+
+    // Separate pass, so listeners see every part already moved
+    static const std::string kPosition = "Position";
+    static const std::string kRotation = "Rotation";
+    for (BasePart *part : parts) {
+        part->FirePropertyChanged(kPosition);
+        if (rotations)
+            part->FirePropertyChanged(kRotation);
+    }
+}
+
+static_assert(sizeof(Vector3Game) == 3 * sizeof(float),
+              "buffers are read as packed Vector3Game");
+
+// Positions or rotations for BulkMoveTo: a buffer of packed float32 x, y, z
+// triples is used in place; an array of Vector3 is copied into storage
+static const Vector3Game *CheckVector3Column(lua_State *L, int idx,
+                                             size_t count,
+                                             std::vector<Vector3Game> &storage) {
+    if (lua_isbuffer(L, idx)) {
+        size_t len = 0;
+        void *data = lua_tobuffer(L, idx, &len);
+        if (len < count * sizeof(Vector3Game))
+            luaL_error(L, "buffer holds %d vectors, expected %d",
+                       (int)(len / sizeof(Vector3Game)), (int)count);
+        return (const Vector3Game *)data;
+    }
+
+    luaL_checktype(L, idx, LUA_TTABLE);
+    if ((size_t)lua_objlen(L, idx) < count)
+        luaL_error(L, "expected %d vectors, got %d", (int)count,
+                   lua_objlen(L, idx));
+
+    storage.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        lua_rawgeti(L, idx, (int)i + 1);
+        storage[i] = Vector3Game_Check(L, -1);
+        lua_pop(L, 1);
+    }
+    return storage.data();
+}
+
+static int Workspace_BulkMoveTo(lua_State *L, Instance *inst) {
+    auto *ws = static_cast<Workspace *>(inst);
+
+    static const ClassId basePartClassId =
+        ClassRegistry::GetClassId(BasePart::StaticClassName);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    int count = lua_objlen(L, 2);
+    std::vector<BasePart *> parts(count);
+    for (int i = 0; i < count; ++i) {
+        lua_rawgeti(L, 2, i + 1);
+        parts[i] = static_cast<BasePart *>(
+            LuaClassBinder::CheckInstance(L, -1, basePartClassId));
+        lua_pop(L, 1);
+    }
+
+    std::vector<Vector3Game> positionStorage;
+    std::vector<Vector3Game> rotationStorage;
+    const Vector3Game *positions =
+        CheckVector3Column(L, 3, parts.size(), positionStorage);
+    const Vector3Game *rotations =
+        lua_isnoneornil(L, 4)
+            ? nullptr
+            : CheckVector3Column(L, 4, parts.size(), rotationStorage);
+
+    BulkMoveMode mode = BulkMoveMode::SkipChangedEvents;
+    if (!lua_isnoneornil(L, 5)) {
+        const char *enumName = nullptr;
+        int value = 0;
+        if (!TryGetEnumItem(L, 5, &enumName, nullptr, &value) ||
+            strcmp(enumName, "BulkMoveMode") != 0)
+            luaL_typeerror(L, 5, "Enum.BulkMoveMode");
+        mode = (BulkMoveMode)value;
+    }
+
+    ws->BulkMoveTo(parts, positions, rotations, mode);
+    return 0;
+}
+
 void Workspace::Bind(lua_State *L) {
     LuaClassBinder::RegisterClass("Workspace", "Instance");
 
-    // Gravity property
-    LuaClassBinder::AddProperty(
-        "Workspace", "Gravity",
-        [](lua_State *L, Instance *inst) -> int {
-            auto *ws = static_cast<Workspace *>(inst);
-            Vector3Game *v =
-                (Vector3Game *)lua_newuserdata(L, sizeof(Vector3Game));
-            *v = ws->Gravity;
-            luaL_getmetatable(L, "Vector3Meta");
-            lua_setmetatable(L, -2);
-            return 1;
-        },
-        [](lua_State *L, Instance *inst, int valueIdx) -> int {
-            auto *ws = static_cast<Workspace *>(inst);
-            Vector3Game *v =
-                (Vector3Game *)luaL_checkudata(L, valueIdx, "Vector3Meta");
-            ws->Gravity = *v;
-            return 0;
-        });
+    LuaClassBinder::AddField<&Workspace::Gravity>("Gravity");
 
     // CurrentCamera property
     LuaClassBinder::AddProperty(
@@ -36,7 +111,8 @@ void Workspace::Bind(lua_State *L) {
         [](lua_State *L, Instance *inst) -> int {
             auto *ws = static_cast<Workspace *>(inst);
             if (ws->CurrentCamera) {
-                // Push camera as light userdata or custom type
+                // Untagged light userdata: the shared light userdata
+                // metatable only acts on tagged Color3 values
                 lua_pushlightuserdata(L, ws->CurrentCamera);
             } else {
                 lua_pushnil(L);
@@ -44,4 +120,6 @@ void Workspace::Bind(lua_State *L) {
             return 1;
         },
         nullptr); // Read-only for now
+
+    LuaClassBinder::AddMethod("Workspace", "BulkMoveTo", Workspace_BulkMoveTo);
 }
\ No newline at end of file
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "../datatypes/Vector3.h"
+#include "../enums/BulkMoveMode.h"
 #include "Instance.h"
 
 #include "../../luau/Compiler/include/luacode.h"
 #include "../../luau/VM/include/lua.h"
 #include "../../luau/VM/include/lualib.h"
 
+struct BasePart;
+
 /**
  * @class Workspace
  * @brief The main container for all physical 3D objects in the game
@@ -20,6 +23,8 @@
  *
  */
 struct Workspace : public Instance {
+    static constexpr const char *StaticClassName = "Workspace";
+
     /**
      * @property Gravity
      * @type Vector3
@@ -38,6 +43,41 @@ struct Workspace : public Instance {
     Workspace();
     virtual ~Workspace() = default;
 
+protected:
+    // Services are singletons and cannot be cloned
+    Instance *CloneInstance() const override { return nullptr; }
+    bool CanDestroy() const override { return false; }
+
+public:
+    /**
+     * @method BulkMoveTo
+     * @param parts table
+     * @param positions table | buffer
+     * @param rotations table | buffer | nil
+     * @param mode BulkMoveMode?
+     * @description Moves many parts in one native call, writing Position
+     * (and Rotation when rotations is given) directly. positions and
+     * rotations are either arrays of Vector3 parallel to parts, or buffers of
+     * packed float32 x, y, z triples (12 bytes per part). Like single
+     * property writes, no Changed events fire unless mode is
+     * Enum.BulkMoveMode.FireChangedEvents.
+     *
+     * @example
+     * ```lua
+     * local positions = buffer.create(#parts * 12)
+     * for i, part in parts do
+     *     buffer.writef32(positions, (i - 1) * 12, i * 4)
+     *     buffer.writef32(positions, (i - 1) * 12 + 4, 5)
+     *     buffer.writef32(positions, (i - 1) * 12 + 8, 0)
+     * end
+     * workspace:BulkMoveTo(parts, positions)
+     * ```
+     */
+    void BulkMoveTo(const std::vector<BasePart *> &parts,
+                    const Vector3Game *positions,
+                    const Vector3Game *rotations = nullptr,
+                    BulkMoveMode mode = BulkMoveMode::SkipChangedEvents);
+
     // Lua bindings
     static void Bind(lua_State *L);
 };
\ No newline at end of file
@@ -53,6 +53,7 @@ static int L_RunChunk(lua_State *L) {
     lua_CompileOptions opts{};
     opts.optimizationLevel = 1;
     opts.debugLevel = 1;
+    Vector3Game_ConfigureCompiler(opts);
     const char *bytecode = luau_compile(src, len, &opts, &bcSize);
 
     int loadStatus = luau_load(L, name, bytecode, bcSize, 0);
@@ -25,10 +25,10 @@ protected:
         baseplate->Color = Color3(Color{92, 92, 92, 0});
         baseplate->Position = Vector3Game{0, -8, 0};
         baseplate->Size = Vector3Game{2048, 16, 2048};
-        baseplate->Name = "Baseplate";
+        baseplate->SetName("Baseplate");
         baseplate->SetParent(workspace);
 
-        g_instances.push_back(baseplate);
+        AddToRenderList(baseplate);
     }
 
     void Cleanup() override {}